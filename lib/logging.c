@@ -20,15 +20,24 @@
 *
 * @author    itworks4u
 * @created   October 12th, 2025
-* @updated   March 27th, 2026
-* @version   1.3.0
+* @updated   October 16th, 2026
+* @version   1.4.0
 */
 
+#ifdef __linux__
+// for fallocate() with FALLOC_FL_KEEP_SIZE
+#define _GNU_SOURCE
+#endif
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdarg.h>
+#include <stdint.h>
+#include <stddef.h>
 #include <time.h>
+#include <ctype.h>
+#include <stdatomic.h>
 #include <sys/stat.h>
 
 #ifdef _WIN32
@@ -43,416 +52,4979 @@
 // for (any) UNIX system
 #include <unistd.h>
 #include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#endif
+
+#ifdef LOG_WITH_ZLIB
+// only, if the compression of rotated files is built in: -DLOG_WITH_ZLIB ... -lz
+#include <zlib.h>
+#endif
+
+#if defined(__linux__) && defined(__has_include) && !defined(LOG_WITHOUT_IO_URING)
+#if __has_include(<linux/io_uring.h>)
+// io_uring for Logging.io_uring_files by its system calls, so no further library is required
+#define LOG_WITH_IO_URING
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#endif
+#endif
+
+#if (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)) && !defined(LOG_WITHOUT_SSE2)
+// 16 characters at once for the escaping of JSON strings, see: _escape_json_string()
+#define LOG_WITH_SSE2
+#include <emmintrin.h>
 #endif
 
 #include "logging.h"
 
 // -----------
-// internal settings
+// threading
 // -----------
 
-/// @brief internal managed log file to use
-static char _log_file_to_use[LENGTH_FILE_NAME];
+#ifdef _WIN32
+typedef HANDLE LogThread;
+typedef SRWLOCK LogMutex;
+typedef CONDITION_VARIABLE LogCondition;
+typedef LPTHREAD_START_ROUTINE LogThreadFunction;
+#define LOG_MUTEX_INITIALIZER SRWLOCK_INIT
+#define LOG_CONDITION_INITIALIZER CONDITION_VARIABLE_INIT
+#define LOG_THREAD_FUNCTION(name) DWORD WINAPI name(LPVOID argument)
+#define LOG_THREAD_EXIT 0
+#else
+typedef pthread_t LogThread;
+typedef pthread_mutex_t LogMutex;
+typedef pthread_cond_t LogCondition;
+typedef void *(*LogThreadFunction)(void *);
+#define LOG_MUTEX_INITIALIZER PTHREAD_MUTEX_INITIALIZER
+#define LOG_CONDITION_INITIALIZER PTHREAD_COND_INITIALIZER
+#define LOG_THREAD_FUNCTION(name) void *name(void *argument)
+#define LOG_THREAD_EXIT NULL
+#endif
 
-/// @brief current timestamp for log event x
-static char _timestamp[LENGTH_TIMESTAMP];
+/// @brief Initialize a single mutex, which hasn't been set up by LOG_MUTEX_INITIALIZER.
+static void _init_mutex(LogMutex *mutex) {
+	#ifdef _WIN32
+	InitializeSRWLock(mutex);
+	#else
+	pthread_mutex_init(mutex, NULL);
+	#endif
+}
 
-/// @brief Contains the previous log file name. More in use for dayly rotation.
-static char _base_log_file[LENGTH_FILE_NAME];
+/// @brief Release a mutex from _init_mutex().
+static void _destroy_mutex(LogMutex *mutex) {
+	#ifdef _WIN32
+	// a SRWLOCK doesn't need to be released
+	(void)mutex;
+	#else
+	pthread_mutex_destroy(mutex);
+	#endif
+}
 
-/// @brief If set, comes from Logging.on_console_only, then no output
-///        is going to write into the file, even a file name by Logging.file_name
-///        has been set.
-static bool _on_console_only = false;
+/// @brief Initialize a mutex and a condition variable, which belong together.
+static void _init_mutex_and_condition(LogMutex *mutex, LogCondition *condition) {
+	#ifdef _WIN32
+	InitializeSRWLock(mutex);
+	InitializeConditionVariable(condition);
+	#else
+	pthread_mutex_init(mutex, NULL);
+	pthread_cond_init(condition, NULL);
+	#endif
+}
 
-/// @brief file pointer to use
-static FILE *_log_file_pointer = NULL;
+/// @brief Release a mutex and a condition variable from _init_mutex_and_condition().
+static void _destroy_mutex_and_condition(LogMutex *mutex, LogCondition *condition) {
+	#ifdef _WIN32
+	// a SRWLOCK and a CONDITION_VARIABLE don't need to be released
+	(void)mutex;
+	(void)condition;
+	#else
+	pthread_cond_destroy(condition);
+	pthread_mutex_destroy(mutex);
+	#endif
+}
 
-/// @brief The log level. Starts with LOG_INFO and will be updated by
-///        Logging.init_level. Every log level, which is at least that level
-///        is going to handle.
-static LogLevel _level_for_logging = LOG_INFO;
+static void _lock_mutex(LogMutex *mutex) {
+	#ifdef _WIN32
+	AcquireSRWLockExclusive(mutex);
+	#else
+	pthread_mutex_lock(mutex);
+	#endif
+}
 
-/// @brief The log rotation setting. Comes from Logging.rotation_setting.
-///        Depending on which rotation setting is set, the file might be updated
-///        on a certain condition.
-static LogRotation _log_rotation = UNSET_ROTATION;
+static void _unlock_mutex(LogMutex *mutex) {
+	#ifdef _WIN32
+	ReleaseSRWLockExclusive(mutex);
+	#else
+	pthread_mutex_unlock(mutex);
+	#endif
+}
 
-/// @brief The size of a file in MB. Defaults to 1MB. Only in use with SIZE_ROTATION.
-static int _size_for_file_size = 1024*1024;
+/// @brief Wait on a condition until it has been signaled or the timeout has been reached.
+///        The mutex must be locked by the caller.
+/// @param timeout_in_ms time to wait at most or <0 to wait until it has been signaled
+static void _wait_on_condition(LogCondition *condition, LogMutex *mutex, int timeout_in_ms) {
+	#ifdef _WIN32
+	SleepConditionVariableSRW(condition, mutex, timeout_in_ms < 0 ? INFINITE : (DWORD)timeout_in_ms, 0);
+	#else
+	if (timeout_in_ms < 0) {
+		pthread_cond_wait(condition, mutex);
+		return;
+	}
 
-/// @brief The number of keeping files for file rotation. Only in use, if
-///        DAILY_ROTATION or SIZE_ROTATION is set.
-static int _nbr_of_keeping_files = 1;
+	struct timespec until;
+	clock_gettime(CLOCK_REALTIME, &until);
+	until.tv_sec += timeout_in_ms / 1000;
+	until.tv_nsec += (long)(timeout_in_ms % 1000) * 1000000L;
 
-/// @brief internal flag to check, if the initializing sequence has been passed trough
-///        to avoid an undefined behavior, when log_to_write() function has been called
-///        without init_log() or init_log_by_arguments()
-static bool _initializing_done = false;
+	if (until.tv_nsec >= 1000000000L) {
+		until.tv_sec += 1;
+		until.tv_nsec -= 1000000000L;
+	}
 
-// -----------
-// fixed expressions
-// -----------
+	pthread_cond_timedwait(condition, mutex, &until);
+	#endif
+}
 
-// only in use, if the file_name exceeds the boundary limit or no
-// file name has been added
-static const char *_default_log_name = "app.log";
+static void _signal_condition(LogCondition *condition) {
+	#ifdef _WIN32
+	WakeConditionVariable(condition);
+	#else
+	pthread_cond_signal(condition);
+	#endif
+}
 
-// rotation names
-static const char *_rotation_strings[] = {"NO_ROTATION", "DAILY_ROTATION", "SIZE_ROTATION"};
+/// @brief Wake up every thread, which waits on the condition.
+static void _broadcast_condition(LogCondition *condition) {
+	#ifdef _WIN32
+	WakeAllConditionVariable(condition);
+	#else
+	pthread_cond_broadcast(condition);
+	#endif
+}
 
-// log types in words
-static const char *_level_strings[] = {"TRACE", "DEBUG", "INFO", "WARN", "ERROR", "FATAL"};
+/// @brief Start a new thread.
+/// @return true, if the thread is running, otherwise false
+static bool _start_thread(LogThread *thread, LogThreadFunction function, void *argument) {
+	#ifdef _WIN32
+	*thread = CreateThread(NULL, 0, function, argument, 0, NULL);
+	return *thread != NULL;
+	#else
+	return pthread_create(thread, NULL, function, argument) == 0;
+	#endif
+}
 
-// log levels:                     |    TRACE   |   DEBUG    |  INFO    |  WARNING  |   ERROR   |   FATAL    |
-// colors for log levels:          |     cyan   | light blue |  green   |   yellow  |  magenta  |    red     |
-static const char *_level_colors[] = {"\x1b[36m", "\x1b[94m", "\x1b[32m", "\x1b[33m", "\x1b[35m", "\x1b[31m"};
+/// @brief Wait, until the given thread has been finished.
+static void _join_thread(LogThread thread) {
+	#ifdef _WIN32
+	WaitForSingleObject(thread, INFINITE);
+	CloseHandle(thread);
+	#else
+	pthread_join(thread, NULL);
+	#endif
+}
+
+/// @brief Give the remaining time slice of the calling thread to another thread.
+static void _yield_thread(void) {
+	#ifdef _WIN32
+	SwitchToThread();
+	#else
+	sched_yield();
+	#endif
+}
 
 // -----------
-// internal functions
+// internal structures
 // -----------
 
-/// @brief Receive the log level as a word. Only a valid range of [0..5]
-///        can be used here. Every other value outside of the range will be handled
-///        with LOG_INFO only.
-/// @param level the level to look for
-/// @return the log level name
-static const char* _log_level_to_string(LogLevel level) {
-	if (level >= LOG_TRACE && level <= LOG_FATAL) {
-		return _level_strings[level];
-	}
+/// @brief Length of a log line without the log message: timestamp, colorized level, brackets and spaces.
+#define LENGTH_LOG_LINE_OVERHEAD (LENGTH_PRECISE_TIMESTAMP + 32)
 
-	return _level_strings[2];
-}
+/// @brief Length of a log line with a log message, which fits into LENGTH_LOG_MESSAGE.
+#define LENGTH_LOG_LINE (LENGTH_LOG_LINE_OVERHEAD + LENGTH_LOG_MESSAGE)
 
-/// @brief Create a new timestamp for the next time event.
-///        The internal managed _timestamp C-string will be updated.
-static void _create_new_timestamp(void) {
-	time_t now = time(NULL);
-	struct tm* t = localtime(&now);
-	memset(_timestamp, '\0', LENGTH_TIMESTAMP);
-	strftime(_timestamp, sizeof(_timestamp), "%Y-%m-%d %H:%M:%S", t);
-}
+/// @brief Length of a JSON line for Logging.json_lines without the log message and the fields.
+#define LENGTH_JSON_LINE_OVERHEAD (LENGTH_PRECISE_TIMESTAMP + 48)
+
+/// @brief Number of characters of an escaped JSON string at most: "\u001f" for each character.
+#define LENGTH_JSON_ESCAPED(length) ((length) * 6)
+
+/// @brief Growable buffer of a thread for log messages, which don't fit into LENGTH_LOG_MESSAGE.
+///        It's reused by each following log event of the same thread and only grows.
+typedef struct {
+	char *data;
+	size_t capacity;
+} ThreadBuffer;
+
+/// @brief One slot of the queue for the background writer in async mode. The sequence
+///        tells producers and the writer thread, if the slot is free or holds a log event.
+typedef struct {
+	atomic_size_t sequence;
+	LogLevel level;
+	char timestamp[LENGTH_PRECISE_TIMESTAMP];
+
+	/// @brief The log message or, if binary_length isn't 0, a record for Logging.binary_format.
+	///        Fields from write_to_log_kv() follow the log message: key and value, each with its '\0'.
+	char message[LENGTH_LOG_MESSAGE];
+	size_t binary_length;
+	size_t nbr_of_fields;
+} AsyncLogSlot;
+
+/// @brief Number of different format strings of a log session with Logging.binary_format. Each further
+///        format string is written as formatted log message.
+#define LOG_BINARY_FORMATS 4096
 
-/// @brief Initiate to rotate the log files. This happens only, if the setting is
-///        set to SIZE_ROTATION. For DAILY_ROTATION take a look to _rotate_log_file_daily().
+/// @brief First bytes of each binary log file.
+#define LOG_BINARY_MAGIC "LOGBIN1\n"
+
+/// @brief Kinds of records in a binary log file.
+typedef enum {
+	BINARY_RECORD_FORMAT = 1,
+	BINARY_RECORD_EVENT = 2,
+	BINARY_RECORD_TEXT = 3
+} BinaryRecordType;
+
+/// @brief Head of each record in a binary log file, followed by length bytes:
+///        BINARY_RECORD_FORMAT: the format string with the number format_id, only written once for each log file
+///        BINARY_RECORD_EVENT:  the raw arguments of a log event for the format string format_id
+///        BINARY_RECORD_TEXT:   a formatted log message, if the arguments can't be recorded
 ///
-///        A rotation to the next file, depending on the given nbr_of_keeping_files is going
-///        to do, if required. If the limitation has been reached, then the oldest file is
-///        going to overwrite.
-static void _rotate_log_files(void) {
-	char rotated_name[FILE_NAME_LOG_ROTATION];
-	char new_name[FILE_NAME_LOG_ROTATION];
+///        The numbers are written in the byte order of the machine, so a binary log file is decoded on the same platform.
+typedef struct {
+	uint8_t type;
+	uint8_t level;
+	uint8_t precision;
+	uint8_t reserved;
+	uint32_t format_id;
+	int64_t seconds;
+	int32_t nanoseconds;
+	uint32_t length;
+} BinaryRecordHead;
 
-	// remove the oldest rotated file, if it exists
-	snprintf(rotated_name, sizeof(rotated_name), "%s.%d", _log_file_to_use, _nbr_of_keeping_files);
-	if (access(rotated_name, F_OK) == 0) {
-		remove(rotated_name);
-	}
+/// @brief A format string, which is known by a log session with Logging.binary_format. Its index in the
+///        table is the number in the binary log file.
+typedef struct {
+	/// @brief The format string of the caller, NULL for a free entry. Set once and read without any lock.
+	_Atomic(const char *) format;
 
-	// shift rotated files up: logfile.(n-1) -> logfile.n
-	for (int i = _nbr_of_keeping_files - 1; i >= 1; --i) {
-		snprintf(rotated_name, sizeof(rotated_name), "%s.%d", _log_file_to_use, i);
-		snprintf(new_name, sizeof(new_name), "%s.%d", _log_file_to_use, i + 1);
+	/// @brief Own copy of the format string. The caller's format string may be a reused buffer.
+	char *text;
 
-		// move old_name to new_name
-		rename(rotated_name, new_name);
-	}
+	/// @brief The number of the log file, which contains this format string already. Only with the file_mutex.
+	unsigned long long written_in_file;
+} BinaryFormat;
 
-	// rename the current log file <file_name>_<date_format>.log to <file_name>_<date_format>.logn
-	// n = [1..nbr_of_keeping_files]
-	snprintf(new_name, sizeof(new_name), "%s.1", _log_file_to_use);
-	rename(_log_file_to_use, new_name);
+/// @brief Kinds of arguments, which are recorded for a conversion of a format string.
+typedef enum {
+	BINARY_ARGUMENT_NONE,
+	BINARY_ARGUMENT_SIGNED,
+	BINARY_ARGUMENT_UNSIGNED,
+	BINARY_ARGUMENT_DOUBLE,
+	BINARY_ARGUMENT_LONG_DOUBLE,
+	BINARY_ARGUMENT_STRING,
+	BINARY_ARGUMENT_POINTER,
+	BINARY_ARGUMENT_UNSUPPORTED
+} BinaryArgumentKind;
 
-	// Now a new log file can be created as _log_file_to_use (e.g., logfile.log)
-}
+/// @brief A single conversion of a format string, e.g. "%-*.3lld".
+typedef struct {
+	/// @brief Number of characters from '%' to the conversion character.
+	size_t length;
+	BinaryArgumentKind kind;
+
+	/// @brief Length modifier: 'H' = hh, 'h', 'l', 'q' = ll, 'j', 'z', 't', 'L' or '\0'
+	char modifier;
+
+	/// @brief If set, then the width or precision comes as int argument before the value.
+	bool width_argument;
+	bool precision_argument;
+
+	/// @brief The precision of the format string or -1.
+	int precision;
+} BinaryConversion;
+
+/// @brief Level of a log session without Logging.flight_recorder: no log event is below it.
+#define LOG_RECORDER_INACTIVE (LOG_FATAL + 1)
+
+/// @brief Head of a log event in the ring buffer of Logging.flight_recorder, followed by the log message with its '\0'
+///        and the fields like in an AsyncLogSlot. A size of 0 marks the end of the used part of the ring buffer,
+///        the next log event starts at its beginning.
+typedef struct {
+	/// @brief Size of the log event in the ring buffer, a multiple of 8.
+	uint32_t size;
+	uint32_t payload_length;
+	uint32_t nbr_of_fields;
+	LogLevel level;
+	struct timespec time;
+} RecordedLogEvent;
+
+/// @brief The ring buffer of a single thread for Logging.flight_recorder. Only its thread keeps log events in it,
+///        so no lock is required.
+typedef struct FlightRecorder {
+	char *data;
+	size_t capacity;
+
+	/// @brief Start of the oldest log event, start of the next log event and the number of kept log events.
+	size_t oldest;
+	size_t next;
+	size_t nbr_of_events;
+
+	/// @brief Identifies the thread of the ring buffer, see: _current_recorder_thread()
+	unsigned long long owner;
+	struct FlightRecorder *next_recorder;
+} FlightRecorder;
+
+/// @brief A rule of set_log_callsites_enabled() or set_log_callsites_level(), which is applied to every callsite of
+///        LOG_CALLSITE_(), when it's registered. A matching callsite below min_level is disabled.
+typedef struct {
+	char file[FILE_NAME_LOG_ROTATION];
+	bool any_file;
+	int line;
+	bool enabled;
+	LogLevel min_level;
+} CallsiteRule;
+
+/// @brief The mapped memory of a log file for Logging.memory_mapped_files. Many threads reserve their
+///        part of it by a single atomic addition and copy their log line without any lock.
+typedef struct {
+	char *data;
+	size_t size;
+
+	/// @brief Next free byte. May grow beyond size, then the segment is full and must be rotated.
+	atomic_size_t offset;
+
+	/// @brief Number of bytes, which have been copied completely. Since every reservation below a failed
+	///        one has been succeeded, this is the real length of the log file after the last copy.
+	atomic_size_t committed;
+
+	/// @brief Number of threads, which are using the segment right now. The segment is only unmapped,
+	///        when no thread is left.
+	atomic_int writers;
 
-/// @brief Thread safe localtime function access. Depending on which OS this application
-///        is running, the real localtime_x function in a certain order, followed by
-///        the correct return value is in use.
-/// @param timestamp the current timestamp
-/// @param out address to struct tm
-/// @return 0, if the called sub function didn't failed, otherwise [result < 0 > result]
-static int _on_safe_localtime(time_t *timestamp, struct tm *out) {
 	#ifdef _WIN32
-	return localtime_s(out, timestamp);
+	HANDLE file;
+	HANDLE mapping;
 	#else
-	return localtime_r(timestamp, out) == NULL;
+	int file_descriptor;
 	#endif
-}
+} MappedSegment;
 
-/// @brief Rotate the log file. Only for DAYLY_ROTATING.
-///        For SIZE_ROTATION take a look to _rotate_log_files().
-///
-///        When a new day has been detected, the log file will be renamed to 
-///        <filename.log>_<timestamp>. <filename.log> becomes a new file to work with
-static void _rotate_log_file_daily(void) {
-	struct stat st;
+#ifdef LOG_WITH_IO_URING
+/// @brief Number of batches of a log session with Logging.io_uring_files. One of them is filled by the
+///        log session, the others may still be written by the kernel at the same time.
+#define LOG_RING_BATCHES 4
 
-	if (stat(_log_file_to_use, &st) != 0) {
-		// general error with stat structure
-		write_to_log(LOG_ERROR, "Unable to use stat for daily rotation: %s", strerror(errno));
-		return;
-	}
+/// @brief The io_uring instance of a log session for Logging.io_uring_files. Every batch is registered
+///        as a fixed buffer, if possible, so the kernel doesn't map it again for each write. Each batch
+///        is written at its own position of the log file, so the order of the completions doesn't matter.
+struct LogRing {
+	int ring_fd;
 
-	time_t now = time(NULL);
+	// submission queue, shared with the kernel
+	void *sq_ring;
+	size_t sq_ring_size;
+	unsigned *sq_tail;
+	unsigned *sq_mask;
+	unsigned *sq_array;
+	struct io_uring_sqe *sqes;
+	size_t sqes_size;
 
-	struct tm now_tm;
-	struct tm file_tm;
+	// completion queue, shared with the kernel; it may be the same mapping as the submission queue
+	void *cq_ring;
+	size_t cq_ring_size;
+	unsigned *cq_head;
+	unsigned *cq_tail;
+	unsigned *cq_mask;
+	struct io_uring_cqe *cqes;
 
-	if (_on_safe_localtime(&now, &now_tm) != 0 || _on_safe_localtime(&st.st_mtime, &file_tm) != 0) {
-		write_to_log(LOG_ERROR, "Unable to set a localtime for daily rotation: %s", strerror(errno));
-		return;
-	}
+	/// @brief If set, then the batches are registered buffers and written by IORING_OP_WRITE_FIXED.
+	bool registered;
 
-	// compare the date stats
-	if (now_tm.tm_year != file_tm.tm_year || now_tm.tm_yday != file_tm.tm_yday) {
-		_rotate_log_files();
-	}
-}
+	/// @brief One allocation for every batch and the state of each batch.
+	char *memory;
+	char *batches[LOG_RING_BATCHES];
+	size_t lengths[LOG_RING_BATCHES];
+	size_t written[LOG_RING_BATCHES];
+	long long offsets[LOG_RING_BATCHES];
+	bool in_flight[LOG_RING_BATCHES];
+	int nbr_in_flight;
 
-#ifdef _WIN32
-// special case(s) for Windows systems only
+	/// @brief The batch, which is filled by the log session right now.
+	int current;
 
-/// @brief Create an error message depending on known error number. Since this comes from
-///        the Windows API, a standard function, like strerror(errno) can't be used here.
-///        Furthermore this function shall also be available for threading.
-///
-///        The error message points to the address of a dynamic C-string. If this doesn't
-///        points to NULL after the function call, this which MUST be freed after its usage.
-///        This can be realized with LocalFree() function.
-/// @param error_number the detected error number
-/// @param error_message the address for the error message
-void _generate_last_error_message(DWORD error_number, char **error_message) {
-	FormatMessageA(
-		FORMAT_MESSAGE_ALLOCATE_BUFFER | FORMAT_MESSAGE_FROM_SYSTEM | FORMAT_MESSAGE_IGNORE_INSERTS,    // dwflags
-		NULL,                                                                                           // lpSource
-		error_number,                                                                                   // dwMEssageId
-		0,                                                                                              // dwLanguageId
-		(LPSTR) error_message,                                                                          // lpBuffer
-		0,                                                                                              // nSize
-		NULL                                                                                            // Arguments
-	);
-}
+	/// @brief The log file of the batches in flight and the position in it for the next batch.
+	int file_descriptor;
+	long long file_offset;
+};
 #endif
 
-/// @brief Check, if a file needs a rotation. Only in use, if DAILY_ROTATION or
-///        SIZE_ROTATION is set. In both cases the Logging.nbr_of_keeping_files is in use.
+/// @brief Kinds of work for the housekeeping thread.
+typedef enum {
+	HOUSEKEEPING_REMOVE_FILE,
+	HOUSEKEEPING_SHIFT_ROTATED_FILES,
+	HOUSEKEEPING_COMPRESS_FILE
+} HousekeepingTask;
+
+/// @brief One piece of work for the housekeeping thread. It holds copies of every name, so it
+///        doesn't depend on the log session, which has created it.
+typedef struct HousekeepingJob {
+	HousekeepingTask task;
+
+	/// @brief HOUSEKEEPING_REMOVE_FILE: the file to remove
+	///        HOUSEKEEPING_SHIFT_ROTATED_FILES: the name of the log file
+	///        HOUSEKEEPING_COMPRESS_FILE: the file to compress into "<file_name>.gz"
+	char file_name[FILE_NAME_LOG_ROTATION];
+
+	/// @brief Only for HOUSEKEEPING_SHIFT_ROTATED_FILES: the renamed log file, which becomes "<file_name>.1"
+	char pending_name[FILE_NAME_LOG_ROTATION];
+	int nbr_of_keeping_files;
+
+	/// @brief If set, then the rotated files are compressed. A removed file may exist as "<name>.gz", too.
+	bool compress;
+
+	struct HousekeepingJob *next;
+} HousekeepingJob;
+
+/// @brief Time in ms between two checks for SIGHUP by the housekeeping thread. The signal handler can't wake it up.
+#define SIGHUP_CHECK_INTERVAL_IN_MS 1000
+
+/// @brief A single background thread for every log session with Logging.background_housekeeping.
+///        It renames and removes rotated files, so a rotation on the caller's thread only has to
+///        rename the current log file and open a new one. The jobs are done in their order.
 ///
-///        SIZE_ROTATION: If the certain Logging.file_size_in_mb has exceeds the limit,
-///        mark for a rotation.
+///        The thread is started by the first log session, which uses it, and stopped by the last one.
+typedef struct {
+	LogMutex mutex;
+	LogCondition job_condition;
+	LogCondition idle_condition;
+	LogThread thread;
+	HousekeepingJob *first_job;
+	HousekeepingJob *last_job;
+	int nbr_of_users;
+	bool busy;
+	bool stop_requested;
+
+	/// @brief Every log session with Logging.config_file. The thread reloads a config file, when it has been changed.
+	///        The number of them with Logging.reload_on_sighup, which keep the handler of SIGHUP installed.
+	struct Logger *first_watched;
+	int nbr_of_sighup_watchers;
+
+	/// @brief Every log session with a batch timer and the one, whose batch is written right now.
+	struct Logger *first_batched;
+	struct Logger *flushing;
+} Housekeeper;
+
+/// @brief Complete state of a log session. Nothing of it is shared with another log session.
+///        The public functions without a handle use _default_logger, every other instance comes
+///        from create_logger().
 ///
-///        DAILY_ROTATION: If a new day starts, mark for a rotation.
-/// @return true, if a rotation is required, otherwise false
-static bool _check_for_new_rotation(void) {
-	bool rotation_is_required = false;
-	int size_in_mb = 0;
+///        Concurrency rules:
+///        - config_mutex serializes initializing and dispose()
+///        - file_mutex protects the file pointer and the rotation state; it's held for
+///          writing a single, already formatted log event only
+///        - the log level and the async flags are atomics and are read without any lock
+struct Logger {
+	LogMutex config_mutex;
+	LogMutex file_mutex;
 
-	#ifdef _WIN32
-	// only for Windows
-	WIN32_FILE_ATTRIBUTE_DATA fileInfo;
-	char *error_message = NULL;
-	DWORD last_error = 0;
+	/// @brief The log level. Starts with LOG_INFO and will be updated by
+	///        Logging.init_level. Every log level, which is at least that level
+	///        is going to handle.
+	atomic_int level_for_logging;
 
-	if (!GetFileAttributesEx(_log_file_to_use, GetFileExInfoStandard, &fileInfo)) {
-		last_error = GetLastError();
-		_generate_last_error_message(last_error, &error_message);
+	/// @brief flag to check, if the initializing sequence has been passed trough
+	///        to avoid an undefined behavior, when write_to_log() function has been called
+	///        without init_log() or init_log_by_arguments()
+	atomic_bool initializing_done;
 
-		if (error_message != NULL) {
-			write_to_log(LOG_ERROR, "Could not get file attributes: %s", error_message);
-			LocalFree(error_message);
-		} else {
-			write_to_log(LOG_ERROR, "Could not get file attributes. (error id: %lu)", last_error);
-		}
+	/// @brief The fraction of a second behind each timestamp. Comes from Logging.timestamp_precision.
+	atomic_int timestamp_precision;
 
-		return false;
-	}
+	/// @brief managed log file to use
+	char log_file_to_use[LENGTH_FILE_NAME];
 
-	// file size in bytes
-	LARGE_INTEGER size;
-	size.HighPart = fileInfo.nFileSizeHigh;
-	size.LowPart = fileInfo.nFileSizeLow;
-	size_in_mb = (int)size.QuadPart;
+	/// @brief If set, comes from Logging.on_console_only, then no output
+	///        is going to write into the file, even a file name by Logging.file_name
+	///        has been set.
+	bool on_console_only;
 
-	WIN32_FIND_DATA file_info_2;
-	HANDLE hFind = FindFirstFile(_log_file_to_use, &file_info_2);
+	/// @brief If set, comes from Logging.keep_file_open, then the log file stays open
+	///        between two log events. Otherwise the file is opened and closed for each log event.
+	bool keep_file_open;
 
-	if (hFind == INVALID_HANDLE_VALUE) {
-		last_error = GetLastError();
-		_generate_last_error_message(last_error, &error_message);
+	/// @brief file pointer to use
+	FILE *log_file_pointer;
 
-		if (error_message != NULL) {
-			write_to_log(LOG_ERROR, "Error with hFind: %s", error_message);
-			LocalFree(error_message);
-		} else {
-			write_to_log(LOG_ERROR, "Error with hFind. (error id: %lu)", last_error);
-		}
+	/// @brief The log rotation setting. Comes from Logging.rotation_setting.
+	///        Depending on which rotation setting is set, the file might be updated
+	///        on a certain condition.
+	LogRotation log_rotation;
 
-		return false;
-	}
+	/// @brief The size of a file in bytes. Only in use with SIZE_ROTATION.
+	long long size_for_file_size;
 
-	// get current local date
-	SYSTEMTIME now;
-	GetLocalTime(&now);
+	/// @brief The number of keeping files for file rotation. Only in use, if
+	///        DAILY_ROTATION or SIZE_ROTATION is set.
+	int nbr_of_keeping_files;
 
-	// get file creation time in local timezone
-	SYSTEMTIME stUTC, stLocal;
-	FileTimeToSystemTime(&fileInfo.ftCreationTime, &stUTC);
-	SystemTimeToTzSpecificLocalTime(NULL, &stUTC, &stLocal);
+	/// @brief How rotated files are named. Comes from Logging.rotation_naming.
+	LogRotationNaming rotation_naming;
 
-	// special case for daily rotation (Windows)
-	if (_log_rotation == DAILY_ROTATION) {
-		rotation_is_required = !(
-			now.wYear == stLocal.wYear &&
-			now.wMonth == stLocal.wMonth &&
-			now.wDay == stLocal.wDay
-		);
-	}
-	
-	FindClose(hFind);
+	/// @brief Sequence number for the next rotated file. Seeded once while initializing by
+	///        a look into the directory of the log file. Only in use with NAMING_SEQUENCE.
+	unsigned long long next_sequence;
 
-	#else
-	// for UNIX systems only
-	struct stat st;
-	if (stat(_log_file_to_use, &st) != 0) {
-		write_to_log(LOG_ERROR, "Unable to use stat for current file: %s", strerror(errno));
-		return false;
-	}
+	/// @brief If set, comes from Logging.background_housekeeping, then rotated files are renamed
+	///        and removed by the housekeeping thread.
+	bool background_housekeeping;
 
-	size_in_mb = (int)st.st_size;
+	/// @brief If set, comes from Logging.compress_rotated_files, then every rotated file is compressed
+	///        to "<name>.gz" by the housekeeping thread. Only available with LOG_WITH_ZLIB.
+	bool compress_rotated_files;
 
-	// NOTE: the POSIX creation time might not be available on all UNIX systems
-	#if defined(__APPLE__) || defined(_MAC)
-		time_t creation_time = st.st_birthtime;
-	#elif defined(_BSD_SOURCE) || defined(__FreeBSD__)
-		time_t creation_time = st.st_ctimespec.tv_sec;
-	#else
-		write_to_log(LOG_TRACE, "The real creation time isn't available on this platform. A fallback mechanism is in use instead.");
-		time_t creation_time = st.st_mtime;
-	#endif
+	/// @brief Number for the next renamed log file, which waits for the housekeeping thread.
+	///        Only in use with NAMING_SHIFT.
+	unsigned long long next_pending_file;
 
-	time_t now = time(NULL);
-	struct tm file_tm, now_tm;
+	/// @brief Number of bytes in the current log file. Seeded once while initializing and
+	///        increased by each written log event. Only in use with SIZE_ROTATION.
+	long long bytes_in_current_file;
 
-	localtime_r(&creation_time, &file_tm);
-	localtime_r(&now, &now_tm);
+	/// @brief Point in time, when the next day begins for the current log file. Seeded once
+	///        while initializing and updated by each rotation. Only in use with DAILY_ROTATION.
+	time_t next_day_boundary;
 
-	// special case for dayly rotation (UNIX system)
-	if (_log_rotation == DAILY_ROTATION) {
-		rotation_is_required = !(
-			file_tm.tm_year == now_tm.tm_year &&
-			file_tm.tm_mon == now_tm.tm_mon &&
-			file_tm.tm_mday == now_tm.tm_mday
-		);
-	}
-	#endif
+	/// @brief If set, comes from Logging.preallocate_files, then each new log file reserves
+	///        size_for_file_size bytes on the disk. Only in use with SIZE_ROTATION.
+	bool preallocate_files;
 
-	// SIZE_ROTATION (available for Windows / UNIX)
-	if (_log_rotation == SIZE_ROTATION) {
-		if (size_in_mb >= _size_for_file_size) {
-			rotation_is_required = true;
-		}
-	}
+	/// @brief If set, then the current log file has been preallocated and must be cut to its
+	///        real length before a rotation or the end of the log session.
+	bool file_preallocated;
 
-	return rotation_is_required;
-}
+	/// @brief If set, comes from Logging.memory_mapped_files, then the log file is mapped into the memory
+	///        and log lines are copied into it. Only in use with SIZE_ROTATION.
+	bool memory_mapped_files;
 
-/// @brief Final log initializer. The settings are come from init_log_by_arguments() or init_log() function(s).
-static void _internal_log_initializer(const char *file_name, const LogLevel init_level, const LogRotation rotation, int size_in_mb, int keep_nbr_files, bool on_console) {
-	_level_for_logging = init_level;
-	int level_warning = 3;
+	/// @brief Two segments, which take turns with each rotation, and the index of the segment in use.
+	///        A thread, which has still the previous segment in hand, sees the changed index and tries again.
+	///        -1, if no segment is mapped.
+	MappedSegment mapped_segments[2];
+	atomic_int current_mapped_segment;
 
-	if (!(_level_for_logging >= LOG_TRACE && _level_for_logging <= LOG_FATAL)) {                                                   // check for an invalid log level setting
-		fprintf(
-			stderr,
-			"%sWarning: invalid log level setting detected. Set the level to %s default.%s\n",
-			_level_colors[level_warning], _level_strings[2], COLOR_RESET
-		);
+	/// @brief If Logging.batch_mode is set, then complete log lines are collected here and
+	///        written into the log file by a single write. Otherwise NULL.
+	char *batch_buffer;
+	size_t batch_capacity;
+	size_t batch_length;
 
-		_level_for_logging = LOG_INFO;
-	}
+	/// @brief Comes from Logging.flush_interval_in_ms and the point in time (monotonic clock
+	///        in ms), when the collected log lines are written at the latest.
+	long long flush_interval_in_ms;
+	long long next_flush_in_ms;
 
-	if (on_console) {
-		_on_console_only = true;
-		_initializing_done = true;
-		return;
-	}
+	/// @brief Without async mode the housekeeping thread writes the batch, when flush_interval_in_ms has been passed,
+	///        see: _start_batch_timer(). The point in time of its next check and the next log session with a batch
+	///        timer are protected by the mutex of the housekeeping thread.
+	bool batch_timer;
+	long long next_timer_flush_in_ms;
+	struct Logger *next_batched;
 
-	// file handling options are selected
-	_nbr_of_keeping_files = (keep_nbr_files - 1);                                                                                  // nbr of files to keep
-	_size_for_file_size *= size_in_mb;                                                                                             // 1024*1024*size_in_mb
+	/// @brief If Logging.io_uring_files is set and io_uring is available, then the batches are submitted
+	///        to the kernel and written without blocking the log session. batch_buffer points into it.
+	///        Otherwise NULL.
+	struct LogRing *ring;
 
-	switch(rotation) {
-		case NO_ROTATION:    // = 0
-			_log_rotation = NO_ROTATION;
-			break;
-		case DAILY_ROTATION: // = 1
-			_log_rotation = DAILY_ROTATION;
-			break;
-		case SIZE_ROTATION:  // = 2
-			_log_rotation = SIZE_ROTATION;
-			break;
-		default:
-			// rotation is outside of [NO_ROTATION..SIZE_ROTATION] or UNSET_ROTATION
-			fprintf(
-				stderr, "%sWarning: Rotation setting is not defined. Using rotation type \"%s\" instead.\n%s",
-				_level_colors[level_warning], _rotation_strings[0], COLOR_RESET
-			);
+	/// @brief If Logging.binary_format is set, then every format string of the log session with its number.
+	///        Otherwise NULL. It's kept by dispose(), so a log event afterwards is still recorded.
+	BinaryFormat *binary_formats;
 
-			_log_rotation = NO_ROTATION;
-			break;
-	}
+	/// @brief Number of the current log file for binary_formats. Increased by each rotation, so every log file
+	///        contains the format strings of its log events.
+	unsigned long long binary_file_number;
 
-	// null terminating file names
-	memset(_log_file_to_use, '\0', sizeof(_log_file_to_use));
-	memset(_base_log_file, '\0', sizeof(_base_log_file));
+	/// @brief If set, comes from Logging.json_lines, then each log event for a file is written as JSON object.
+	bool json_lines;
 
-	if (file_name == NULL) {                                                                                                       // check, if the file name points to NULL
-		fprintf(
-			stderr, "%sWarning: Invalid file name detected. Using \"%s\" as file name instead.\n%s",
-			_level_colors[level_warning], _default_log_name, COLOR_RESET
-		);
+	/// @brief Comes from Logging.repeat_window_in_ms, 0 without Logging.suppress_repeated_messages.
+	long long repeat_window_in_ms;
 
-		strcpy(_log_file_to_use, _default_log_name);
-	} else {
-		size_t name_length = strlen(file_name);
+	/// @brief The last written log message with its fields like in an AsyncLogSlot, its level and the number of suppressed
+	///        repetitions since repeat_since_in_ms (monotonic clock in ms). repeat_payload_length is 0, if no log message
+	///        is kept. Only with the file_mutex.
+	char repeat_payload[LENGTH_LOG_MESSAGE];
+	size_t repeat_payload_length;
+	size_t repeat_message_length;
+	size_t repeat_nbr_of_fields;
+	LogLevel repeat_level;
+	unsigned long long repeat_count;
+	long long repeat_since_in_ms;
 
-		if (name_length > 0 && name_length < LENGTH_FILE_NAME) {                                                                   // check for valid file size length [1..31]
-			strcpy(_log_file_to_use, file_name);
-		} else {
-			fprintf(
-				stderr,
-				"%sWarning: Invalid length (%d) for file name detected. Using a default file name \"%s\" instead.%s\n",
-				_level_colors[level_warning], (int) name_length, _default_log_name, COLOR_RESET
-			);
-			strcpy(_log_file_to_use, _default_log_name);
-		}
-	}
+	/// @brief Comes from Logging.flight_recorder_level. Log events from this level up to level_for_logging are kept
+	///        in the ring buffer of their thread. LOG_RECORDER_INACTIVE without Logging.flight_recorder.
+	atomic_int recorder_level;
 
-	if (_log_rotation != NO_ROTATION) {                                                                                            // special handling for DAILY_ROTATION and SIZE_ROTATION
-		if (_size_for_file_size < 1 && _log_rotation == SIZE_ROTATION) {                                                           // check for invalid SIZE_ROTATION setting
-			fprintf(
-				stderr,
-				"%sWarning: Invalid size in MB for for option %s detected. Switching to option \"%s\" instead.%s\n",
-				_level_colors[level_warning], _rotation_strings[2], _rotation_strings[0], COLOR_RESET
-			);
+	/// @brief Size of the ring buffer of each thread and every ring buffer of the log session. Only with the file_mutex.
+	size_t recorder_capacity;
+	FlightRecorder *flight_recorders;
 
-			_log_rotation = NO_ROTATION;
-		}
+	/// @brief Unique number of the log session with Logging.flight_recorder, 0 without it. A thread detects by it,
+	///        that its ring buffer belongs to a previous log session.
+	unsigned long long recorder_session;
 
-		if (_nbr_of_keeping_files < 2) {                                                                                           // check for invalid keep_nbr_files setting
+	/// @brief Set, if at least one level has a rate limit from Logging.rate_limits. The token bucket of each level
+	///        is kept as its theoretical arrival time (monotonic clock in ns): a log event is allowed, as long as it's
+	///        at most rate_burst_in_ns ahead of now, and moves it by rate_interval_in_ns. 0 as interval is unlimited.
+	atomic_bool rate_limited;
+	long long rate_interval_in_ns[LOG_FATAL + 1];
+	long long rate_burst_in_ns[LOG_FATAL + 1];
+	atomic_llong rate_arrival_in_ns[LOG_FATAL + 1];
+
+	/// @brief Log events of each level, which are suppressed by LOG_SAMPLED_() or a rate limit since the last report,
+	///        and every suppressed log event of the log session.
+	atomic_ullong suppressed_by_level[LOG_FATAL + 1];
+	atomic_ullong suppressed_log_events;
+
+	/// @brief Comes from Logging.suppression_report_interval_in_ms and the point in time (monotonic clock in ms),
+	///        when the suppressed log events are reported next.
+	long long report_interval_in_ms;
+	atomic_llong next_report_in_ms;
+
+	/// @brief Comes from Logging.config_file, which is reloaded by the housekeeping thread. Empty without it.
+	///        The version of the config file (modification time and size), when it has been read, and the point in time
+	///        (monotonic clock in ms) of the next check. Only with the mutex of the housekeeping thread.
+	char config_file[FILE_NAME_LOG_ROTATION];
+	long long config_version;
+	long long config_check_interval_in_ms;
+	long long next_config_check_in_ms;
+	bool config_reload_requested;
+	bool reload_on_sighup;
+	struct Logger *next_watched;
+
+	/// @brief If set, comes from Logging.async_mode, then log events for a file are going to
+	///        hand over to a background writer thread instead of writing them on the caller's thread.
+	atomic_bool async_mode;
+
+	/// @brief Number of threads, which are putting a log event into the queue right now.
+	///        The queue is only released, when no producer is left.
+	atomic_int async_producers;
+
+	/// @brief Number of log events, which are lost because of a full queue in async mode.
+	atomic_ullong dropped_log_events;
+
+	/// @brief Number of log messages, which have been cut at LENGTH_LOG_MESSAGE.
+	atomic_ullong truncated_log_events;
+
+	/// @brief Bounded queue for async mode. Many threads are able to put a log event into it
+	///        without a lock, but only the background writer thread takes them out.
+	AsyncLogSlot *async_slots;
+
+	/// @brief Number of slots - 1. The number of slots is always a power of 2.
+	size_t async_mask;
+
+	/// @brief Next position to fill by a producer and next position to take by the writer thread.
+	///        Both are kept apart by a cache line, since they are changed by different threads.
+	atomic_size_t async_enqueue_position;
+	char async_padding[64];
+	atomic_size_t async_dequeue_position;
+
+	/// @brief What to do, if the queue is full. Comes from Logging.overflow_policy.
+	LogOverflowPolicy overflow_policy;
+
+	/// @brief The background writer thread in async mode and its wake up signal.
+	LogThread async_writer;
+	LogMutex async_mutex;
+	LogCondition async_condition;
+	atomic_bool async_writer_sleeping;
+	atomic_bool async_stop_requested;
+};
+
+// -----------
+// internal settings
+// -----------
+
+/// @brief The log session, which is used by the public functions.
+static Logger _default_logger = {
+	.config_mutex = LOG_MUTEX_INITIALIZER,
+	.file_mutex = LOG_MUTEX_INITIALIZER,
+	.level_for_logging = LOG_INFO,
+	.recorder_level = LOG_RECORDER_INACTIVE,
+	.current_mapped_segment = -1,
+	.log_rotation = UNSET_ROTATION,
+	.size_for_file_size = 1024 * 1024,
+	.nbr_of_keeping_files = 1
+};
+
+/// @brief Copy of the lowest handled log level of the default log session for the LOG_*_() macros in logging.h.
+///        Only a read only view is public, so the macros can't change it.
+static atomic_int _level_for_logging = LOG_INFO;
+const atomic_int *const log_internal_handled_level = &_level_for_logging;
+
+/// @brief Every registered callsite of LOG_CALLSITE_() and the rules of set_log_callsites_enabled() and set_log_callsites_level().
+///        Only with the _callsite_mutex, the state of a callsite is read without it.
+static LogMutex _callsite_mutex = LOG_MUTEX_INITIALIZER;
+static LogCallsite *_log_callsites = NULL;
+static CallsiteRule _callsite_rules[MAX_LOG_CALLSITE_RULES];
+static int _nbr_of_callsite_rules = 0;
+
+/// @brief Set by SIGHUP for Logging.reload_on_sighup.
+static atomic_bool _config_reload_signaled = false;
+
+#ifndef _WIN32
+/// @brief The handler of SIGHUP before the first log session with Logging.reload_on_sighup. It's restored by the last one.
+///        Only with the mutex of the housekeeping thread.
+static struct sigaction _previous_sighup_action;
+#endif
+
+/// @brief The housekeeping thread, which is shared by every log session. See: _use_housekeeper()
+static Housekeeper _housekeeper = {
+	.mutex = LOG_MUTEX_INITIALIZER,
+	.job_condition = LOG_CONDITION_INITIALIZER,
+	.idle_condition = LOG_CONDITION_INITIALIZER
+};
+
+/// @brief The second of the last formatted timestamp of the current thread. See: _create_new_timestamp()
+static _Thread_local time_t _cached_second = (time_t)-1;
+
+/// @brief The last formatted timestamp of the current thread. See: _create_new_timestamp()
+static _Thread_local char _cached_timestamp[LENGTH_TIMESTAMP];
+
+/// @brief Buffers of the current thread for a long log message and its log line. See: _reserve_thread_buffer()
+static _Thread_local ThreadBuffer _long_message_buffer;
+static _Thread_local ThreadBuffer _long_line_buffer;
+
+/// @brief Buffer of the current thread for the fields of a binary log event, which are recorded as text behind the
+///        log message. The log message itself may be in _long_message_buffer.
+static _Thread_local ThreadBuffer _fields_text_buffer;
+
+/// @brief The key, whose destructor releases the buffers of a thread, when it ends, and whether the current thread has
+///        been registered for it. See: _register_thread_buffers()
+#ifdef _WIN32
+static DWORD _thread_buffers_key = FLS_OUT_OF_INDEXES;
+static INIT_ONCE _thread_buffers_key_once = INIT_ONCE_STATIC_INIT;
+#else
+static pthread_key_t _thread_buffers_key;
+static bool _thread_buffers_key_created = false;
+static pthread_once_t _thread_buffers_key_once = PTHREAD_ONCE_INIT;
+#endif
+static _Thread_local bool _thread_buffers_registered;
+
+/// @brief The ring buffer of the current thread for Logging.flight_recorder and its log session. See: _find_flight_recorder()
+static _Thread_local FlightRecorder *_flight_recorder;
+static _Thread_local const Logger *_recorder_logger;
+static _Thread_local unsigned long long _recorder_session;
+
+/// @brief Number of the current thread for its ring buffers, 0 until its first use. See: _current_recorder_thread()
+static _Thread_local unsigned long long _recorder_thread;
+
+/// @brief Number of threads with a ring buffer so far.
+static atomic_ullong _recorder_threads;
+
+/// @brief Number of log sessions with Logging.flight_recorder so far. See: Logger.recorder_session
+static atomic_ullong _flight_recorder_sessions;
+
+// -----------
+// fixed expressions
+// -----------
+
+// only in use, if the file_name exceeds the boundary limit or no
+// file name has been added
+static const char *_default_log_name = "app.log";
+
+// rotation names
+static const char *_rotation_strings[] = {"NO_ROTATION", "DAILY_ROTATION", "SIZE_ROTATION"};
+
+// log types in words
+static const char *_level_strings[] = {"TRACE", "DEBUG", "INFO", "WARN", "ERROR", "FATAL"};
+
+// log levels:                     |    TRACE   |   DEBUG    |  INFO    |  WARNING  |   ERROR   |   FATAL    |
+// colors for log levels:          |     cyan   | light blue |  green   |   yellow  |  magenta  |    red     |
+static const char *_level_colors[] = {"\x1b[36m", "\x1b[94m", "\x1b[32m", "\x1b[33m", "\x1b[35m", "\x1b[31m"};
+
+// -----------
+// internal functions
+// -----------
+
+/// @brief Receive the log level as a word. Only a valid range of [0..5]
+///        can be used here. Every other value outside of the range will be handled
+///        with LOG_INFO only.
+/// @param level the level to look for
+/// @return the log level name
+static const char* _log_level_to_string(LogLevel level) {
+	if (level >= LOG_TRACE && level <= LOG_FATAL) {
+		return _level_strings[level];
+	}
+
+	return _level_strings[2];
+}
+
+/// @brief Thread safe localtime function access. Depending on which OS this application
+///        is running, the real localtime_x function in a certain order, followed by
+///        the correct return value is in use.
+/// @param timestamp the current timestamp
+/// @param out address to struct tm
+/// @return 0, if the called sub function didn't failed, otherwise [result < 0 > result]
+static int _on_safe_localtime(time_t *timestamp, struct tm *out) {
+	#ifdef _WIN32
+	return localtime_s(out, timestamp);
+	#else
+	return localtime_r(timestamp, out) == NULL;
+	#endif
+}
+
+/// @brief Read the current wall clock time.
+///
+///        If only seconds are required, then the coarse clock is in use, which is just a memory read on Linux.
+///        Otherwise the precise clock is in use: on Linux served by the vDSO without any syscall,
+///        on Windows by GetSystemTimePreciseAsFileTime().
+/// @param now the current time
+/// @param precise true, if a fraction of a second is required
+static void _read_clock(struct timespec *now, bool precise) {
+	#ifdef _WIN32
+	if (!precise) {
+		now->tv_sec = time(NULL);
+		now->tv_nsec = 0;
+		return;
+	}
+
+	// 100ns intervals since January 1st, 1601 => January 1st, 1970
+	FILETIME file_time;
+	GetSystemTimePreciseAsFileTime(&file_time);
+
+	ULARGE_INTEGER intervals;
+	intervals.HighPart = file_time.dwHighDateTime;
+	intervals.LowPart = file_time.dwLowDateTime;
+	intervals.QuadPart -= 116444736000000000ULL;
+
+	now->tv_sec = (time_t)(intervals.QuadPart / 10000000ULL);
+	now->tv_nsec = (long)(intervals.QuadPart % 10000000ULL) * 100L;
+	#else
+	#ifdef CLOCK_REALTIME_COARSE
+	clock_gettime(precise ? CLOCK_REALTIME : CLOCK_REALTIME_COARSE, now);
+	#else
+	(void)precise;
+	clock_gettime(CLOCK_REALTIME, now);
+	#endif
+	#endif
+}
+
+/// @brief Monotonic clock in milliseconds. Only in use to decide, when a batch is written.
+static long long _now_in_ms(void) {
+	#ifdef _WIN32
+	return (long long)GetTickCount64();
+	#else
+	struct timespec now;
+
+	#ifdef CLOCK_MONOTONIC_COARSE
+	clock_gettime(CLOCK_MONOTONIC_COARSE, &now);
+	#else
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	#endif
+
+	return (long long)now.tv_sec * 1000LL + now.tv_nsec / 1000000L;
+	#endif
+}
+
+/// @brief Precise monotonic clock in nanoseconds. Only in use for the rate limits of Logging.rate_limits.
+static long long _now_in_ns(void) {
+	#ifdef _WIN32
+	static LARGE_INTEGER frequency;
+	LARGE_INTEGER now;
+
+	if (frequency.QuadPart == 0) {
+		QueryPerformanceFrequency(&frequency);
+	}
+
+	QueryPerformanceCounter(&now);
+	return now.QuadPart / frequency.QuadPart * 1000000000LL + now.QuadPart % frequency.QuadPart * 1000000000LL / frequency.QuadPart;
+	#else
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (long long)now.tv_sec * 1000000000LL + now.tv_nsec;
+	#endif
+}
+
+/// @brief Append the fraction of a second to a timestamp, e.g. ".123" for milliseconds.
+///        The digits are written by hand to avoid another call of a printf-like function.
+/// @param destination the end of the timestamp, where the fraction starts
+/// @param nanoseconds nanoseconds of the current second
+/// @param precision the precision of the fraction; TIMESTAMP_SECONDS appends nothing
+static void _append_fraction_of_second(char *destination, long nanoseconds, LogTimestampPrecision precision) {
+	// number of digits and divisor for:  seconds | milliseconds | microseconds | nanoseconds
+	static const int digits_for_precision[] = {0, 3, 6, 9};
+	static const long divisor_for_precision[] = {1000000000L, 1000000L, 1000L, 1L};
+
+	int digits = digits_for_precision[precision];
+
+	if (digits == 0) {
+		return;
+	}
+
+	long fraction = nanoseconds / divisor_for_precision[precision];
+	destination[0] = '.';
+
+	for (int i = digits; i >= 1; i--) {
+		destination[i] = (char)('0' + fraction % 10);
+		fraction /= 10;
+	}
+
+	destination[digits + 1] = '\0';
+}
+
+/// @brief Format a point in time as timestamp.
+///
+///        The formatted timestamp is cached per thread. Only if the second has been changed
+///        since the last call of this thread, localtime and strftime are in use again.
+///        Otherwise the cached timestamp is just copied and the fraction of a second is appended.
+/// @param timestamp the C-string to update with at least LENGTH_PRECISE_TIMESTAMP characters
+/// @param now the point in time
+/// @param precision the fraction of a second behind the timestamp
+static void _format_timestamp(char *timestamp, const struct timespec *now, LogTimestampPrecision precision) {
+	if (!(precision >= TIMESTAMP_SECONDS && precision <= TIMESTAMP_NANOSECONDS)) {
+		precision = TIMESTAMP_SECONDS;
+	}
+
+	if (now->tv_sec != _cached_second) {
+		struct tm t;
+		time_t second = now->tv_sec;
+		memset(_cached_timestamp, '\0', LENGTH_TIMESTAMP);
+
+		if (_on_safe_localtime(&second, &t) == 0) {
+			strftime(_cached_timestamp, LENGTH_TIMESTAMP, "%Y-%m-%d %H:%M:%S", &t);
+		}
+
+		_cached_second = now->tv_sec;
+	}
+
+	memcpy(timestamp, _cached_timestamp, LENGTH_TIMESTAMP);
+	_append_fraction_of_second(timestamp + strlen(timestamp), now->tv_nsec, precision);
+}
+
+/// @brief Create a new timestamp for the next time event. See: _format_timestamp()
+/// @param timestamp the C-string to update with at least LENGTH_PRECISE_TIMESTAMP characters
+/// @param precision the fraction of a second behind the timestamp
+static void _create_new_timestamp(char *timestamp, LogTimestampPrecision precision) {
+	struct timespec now;
+	_read_clock(&now, precision != TIMESTAMP_SECONDS);
+	_format_timestamp(timestamp, &now, precision);
+}
+
+/// @brief Shift the rotated files of NAMING_SHIFT up: the oldest one is removed, logfile.(n-1) -> logfile.n
+///        and at last the given newest file becomes logfile.1.
+/// @param file_name name of the log file
+/// @param nbr_of_keeping_files number of rotated files
+/// @param newest_file the file, which becomes logfile.1; the log file itself or a renamed log file
+/// @param compressed true, if the rotated files are named logfile.n.gz
+static void _shift_rotated_files(const char *file_name, int nbr_of_keeping_files, const char *newest_file, bool compressed) {
+	char rotated_name[FILE_NAME_LOG_ROTATION];
+	char new_name[FILE_NAME_LOG_ROTATION];
+	const char *suffix = compressed ? ".gz" : "";
+
+	// remove the oldest rotated file, if it exists
+	snprintf(rotated_name, sizeof(rotated_name), "%s.%d%s", file_name, nbr_of_keeping_files, suffix);
+	if (access(rotated_name, F_OK) == 0) {
+		remove(rotated_name);
+	}
+
+	// shift rotated files up: logfile.(n-1) -> logfile.n
+	for (int i = nbr_of_keeping_files - 1; i >= 1; --i) {
+		snprintf(rotated_name, sizeof(rotated_name), "%s.%d%s", file_name, i, suffix);
+		snprintf(new_name, sizeof(new_name), "%s.%d%s", file_name, i + 1, suffix);
+
+		// move old_name to new_name
+		rename(rotated_name, new_name);
+	}
+
+	// rename the current log file <file_name>_<date_format>.log to <file_name>_<date_format>.logn
+	// n = [1..nbr_of_keeping_files]
+	snprintf(new_name, sizeof(new_name), "%s.1", file_name);
+	rename(newest_file, new_name);
+}
+
+/// @brief Compress a rotated file into "<file_name>.gz" and remove the uncompressed file afterwards.
+///        If anything fails, then the uncompressed file is kept.
+/// @param file_name the rotated file to compress
+static void _compress_file(const char *file_name) {
+	#ifdef LOG_WITH_ZLIB
+	char compressed_name[FILE_NAME_LOG_ROTATION];
+	snprintf(compressed_name, sizeof(compressed_name), "%s.gz", file_name);
+
+	FILE *source = fopen(file_name, "rb");
+
+	if (source == NULL) {
+		return;
+	}
+
+	gzFile destination = gzopen(compressed_name, "wb6");
+
+	if (destination == NULL) {
+		fclose(source);
+		fprintf(stderr, "%sERROR: unable to create the compressed file \"%s\".%s\n", _level_colors[4], compressed_name, COLOR_RESET);
+		return;
+	}
+
+	char buffer[64 * 1024];
+	size_t length;
+	bool valid = true;
+
+	while (valid && (length = fread(buffer, 1, sizeof(buffer), source)) > 0) {
+		valid = gzwrite(destination, buffer, (unsigned)length) == (int)length;
+	}
+
+	valid = !ferror(source) && valid;
+	fclose(source);
+	valid = gzclose(destination) == Z_OK && valid;
+
+	if (valid) {
+		remove(file_name);
+	} else {
+		fprintf(stderr, "%sERROR: unable to compress the rotated file \"%s\".%s\n", _level_colors[4], file_name, COLOR_RESET);
+		remove(compressed_name);
+	}
+	#else
+	(void)file_name;
+	#endif
+}
+
+/// @brief Check, if a rule of set_log_callsites_enabled() matches a callsite. The file of the rule must be the end of
+///        the file of the callsite after a path separator, e.g. "parser.c" matches "src/parser.c", but not "myparser.c".
+static bool _is_callsite_matching(const LogCallsite *callsite, const CallsiteRule *rule) {
+	if (rule->line != 0 && rule->line != callsite->line) {
+		return false;
+	}
+
+	if (rule->any_file) {
+		return true;
+	}
+
+	size_t file_length = strlen(callsite->file);
+	size_t rule_length = strlen(rule->file);
+
+	if (rule_length > file_length || strcmp(callsite->file + file_length - rule_length, rule->file) != 0) {
+		return false;
+	}
+
+	char separator = rule_length < file_length ? callsite->file[file_length - rule_length - 1] : '/';
+	return separator == '/' || separator == '\\';
+}
+
+/// @brief Apply a rule to every registered callsite of LOG_CALLSITE_() and keep it for the callsites, which are
+///        registered afterwards. See: set_log_callsites_enabled()
+/// @param file the end of the source file name of the callsites; NULL for every file
+/// @param line the line of the callsite; 0 for every line
+/// @param enabled true to enable, false to disable the callsites
+/// @param min_level every matching callsite below this level is disabled
+/// @return number of registered callsites, which match
+static int _add_callsite_rule(const char *file, int line, bool enabled, LogLevel min_level) {
+	int level_warning = 3;
+	CallsiteRule rule = {.any_file = file == NULL, .line = line < 0 ? 0 : line, .enabled = enabled, .min_level = min_level};
+	int matches = 0;
+
+	if (file != NULL) {
+		snprintf(rule.file, sizeof(rule.file), "%s", file);
+	}
+
+	_lock_mutex(&_callsite_mutex);
+
+	for (LogCallsite *callsite = _log_callsites; callsite != NULL; callsite = callsite->next) {
+		if (_is_callsite_matching(callsite, &rule)) {
+			bool callsite_enabled = enabled && callsite->level >= min_level;
+			atomic_store_explicit(&callsite->state, callsite_enabled ? CALLSITE_ENABLED : CALLSITE_DISABLED, memory_order_relaxed);
+			matches++;
+		}
+	}
+
+	// the same rule again replaces the previous one, so it's applied in the new order
+	int i = 0;
+
+	while (i < _nbr_of_callsite_rules && !(
+		_callsite_rules[i].any_file == rule.any_file && _callsite_rules[i].line == rule.line && strcmp(_callsite_rules[i].file, rule.file) == 0
+	)) {
+		i++;
+	}
+
+	if (i < _nbr_of_callsite_rules) {
+		memmove(&_callsite_rules[i], &_callsite_rules[i + 1], (size_t)(_nbr_of_callsite_rules - i - 1) * sizeof(CallsiteRule));
+		_nbr_of_callsite_rules--;
+	}
+
+	if (_nbr_of_callsite_rules < MAX_LOG_CALLSITE_RULES) {
+		_callsite_rules[_nbr_of_callsite_rules++] = rule;
+	} else {
+		fprintf(
+			stderr, "%sWarning: no space for another callsite rule. Only the registered callsites have been changed.%s\n",
+			_level_colors[level_warning], COLOR_RESET
+		);
+	}
+
+	_unlock_mutex(&_callsite_mutex);
+	return matches;
+}
+
+/// @brief Set the log level of a log session without any lock. The LOG_*_() macros see it at once.
+/// @param level the new log level, which has been checked already
+static void _set_logger_level(Logger *logger, LogLevel level) {
+	atomic_store_explicit(&logger->level_for_logging, level, memory_order_release);
+
+	if (logger == &_default_logger) {
+		// the flight recorder may handle a lower level
+		int recorder_level = atomic_load_explicit(&logger->recorder_level, memory_order_relaxed);
+		atomic_store_explicit(&_level_for_logging, recorder_level < (int)level ? recorder_level : (int)level, memory_order_release);
+	}
+}
+
+/// @brief Parse the name of a log level like in a log line, e.g. "DEBUG" or "warn". "WARNING" is accepted, too.
+/// @return the log level or -1, if the name is unknown
+static int _parse_log_level(const char *name) {
+	char upper[16];
+	size_t length = 0;
+
+	while (name[length] != '\0' && length < sizeof(upper) - 1) {
+		upper[length] = (char)toupper((unsigned char)name[length]);
+		length++;
+	}
+
+	upper[length] = '\0';
+
+	for (int level = LOG_TRACE; level <= LOG_FATAL; level++) {
+		if (strcmp(upper, _level_strings[level]) == 0) {
+			return level;
+		}
+	}
+
+	return strcmp(upper, "WARNING") == 0 ? LOG_WARNING : -1;
+}
+
+/// @brief Remove the white spaces around a text.
+static char *_trim(char *text) {
+	char *end = text + strlen(text);
+
+	while (*text == ' ' || *text == '\t') {
+		text++;
+	}
+
+	while (end > text && (end[-1] == ' ' || end[-1] == '\t' || end[-1] == '\r' || end[-1] == '\n')) {
+		*--end = '\0';
+	}
+
+	return text;
+}
+
+/// @brief Read a config file and apply it to a log session. Each line is "key = value", '#' starts a comment:
+///        level = DEBUG                   the log level of the log session
+///        callsite parser.c = WARN        callsites of LOG_CALLSITE_() in parser.c below LOG_WARNING are disabled
+///        callsite parser.c:42 = off      a single callsite is disabled ("on" enables it again, "*" is every file)
+///        An invalid line is ignored with a warning.
+/// @param file_name the config file
+/// @return true, if the config file has been read and every line is valid
+static bool _apply_log_config(Logger *logger, const char *file_name) {
+	int level_warning = 3;
+	FILE *file = fopen(file_name, "r");
+	char buffer[FILE_NAME_LOG_ROTATION + 64];
+	int line_number = 0;
+	bool valid = file != NULL;
+
+	if (file == NULL) {
+		fprintf(stderr, "%sWarning: unable to read the config file \"%s\": %s%s\n", _level_colors[level_warning], file_name, strerror(errno), COLOR_RESET);
+		return false;
+	}
+
+	while (fgets(buffer, sizeof(buffer), file) != NULL) {
+		char *comment = strchr(buffer, '#');
+		char *equals = strchr(buffer, '=');
+		line_number++;
+
+		if (comment != NULL) {
+			*comment = '\0';
+		}
+
+		if (*_trim(buffer) == '\0') {
+			continue;
+		}
+
+		int level = -1;
+		bool applied = false;
+
+		if (equals != NULL && (comment == NULL || equals < comment)) {
+			*equals = '\0';
+			char *key = _trim(buffer);
+			char *value = _trim(equals + 1);
+			level = _parse_log_level(value);
+
+			if (strcmp(key, "level") == 0 && level >= 0) {
+				_set_logger_level(logger, (LogLevel)level);
+				applied = true;
+			} else if (strncmp(key, "callsite", 8) == 0 && (key[8] == ' ' || key[8] == '\t')) {
+				// "<file>[:<line>]", a colon of a Windows path isn't followed by digits only
+				char *target = _trim(key + 8);
+				char *colon = strrchr(target, ':');
+				int line = 0;
+
+				if (colon != NULL && colon[1] != '\0' && strspn(colon + 1, "0123456789") == strlen(colon + 1)) {
+					line = atoi(colon + 1);
+					*colon = '\0';
+				}
+
+				const char *file_of_rule = strcmp(target, "*") == 0 ? NULL : target;
+				applied = *target != '\0';
+
+				if (!applied) {
+					// no file at all
+				} else if (strcmp(value, "on") == 0 || strcmp(value, "off") == 0) {
+					_add_callsite_rule(file_of_rule, line, strcmp(value, "on") == 0, LOG_TRACE);
+				} else if (level >= 0) {
+					_add_callsite_rule(file_of_rule, line, true, (LogLevel)level);
+				} else {
+					applied = false;
+				}
+			}
+		}
+
+		if (!applied) {
+			fprintf(
+				stderr, "%sWarning: line %d of the config file \"%s\" is invalid and has been ignored.%s\n",
+				_level_colors[level_warning], line_number, file_name, COLOR_RESET
+			);
+			valid = false;
+		}
+	}
+
+	fclose(file);
+	return valid;
+}
+
+/// @brief Version of a config file, which is changed by each write: its modification time and its size.
+/// @return the version or -1, if the file doesn't exist
+static long long _config_file_version(const char *file_name) {
+	struct stat info;
+
+	if (stat(file_name, &info) != 0) {
+		return -1;
+	}
+
+	unsigned long long nanoseconds = 0;
+
+	#if defined(__linux__)
+	nanoseconds = (unsigned long long)info.st_mtim.tv_nsec;
+	#endif
+
+	// only compared for equality, so an overflow doesn't matter
+	unsigned long long version = ((unsigned long long)info.st_mtime * 1000000000ULL + nanoseconds) * 31 + (unsigned long long)info.st_size;
+	return (long long)(version & 0x7FFFFFFFFFFFFFFFULL);
+}
+
+#ifndef _WIN32
+/// @brief Handler of SIGHUP for Logging.reload_on_sighup. Only a flag is set, the housekeeping thread does the reload.
+static void _on_sighup(int signal_number) {
+	(void)signal_number;
+	atomic_store(&_config_reload_signaled, true);
+}
+#endif
+
+/// @brief Reload the config file of a log session, if it has been changed or SIGHUP has been received. Only a single
+///        config file is read without the lock, so a log session may stop its watch in the meantime.
+///        Called by the housekeeping thread with its mutex.
+/// @return time in ms until the next check or -1, if no config file is watched
+static int _check_config_files(void) {
+	long long now = _now_in_ms();
+	long long timeout_in_ms = _housekeeper.nbr_of_sighup_watchers > 0 ? SIGHUP_CHECK_INTERVAL_IN_MS : -1;
+
+	if (atomic_exchange(&_config_reload_signaled, false)) {
+		for (Logger *logger = _housekeeper.first_watched; logger != NULL; logger = logger->next_watched) {
+			logger->config_reload_requested = true;
+		}
+	}
+
+	for (Logger *logger = _housekeeper.first_watched; logger != NULL; logger = logger->next_watched) {
+		if (logger->config_reload_requested || now >= logger->next_config_check_in_ms) {
+			long long version = _config_file_version(logger->config_file);
+			logger->next_config_check_in_ms = now + logger->config_check_interval_in_ms;
+
+			if (logger->config_reload_requested || (version != logger->config_version && version != -1)) {
+				logger->config_reload_requested = false;
+				logger->config_version = version;
+
+				// _leave_housekeeper() waits, until the log session isn't in use anymore
+				_housekeeper.busy = true;
+				_unlock_mutex(&_housekeeper.mutex);
+				_apply_log_config(logger, logger->config_file);
+				_lock_mutex(&_housekeeper.mutex);
+				_housekeeper.busy = false;
+				_broadcast_condition(&_housekeeper.idle_condition);
+
+				// the watched log sessions may have been changed
+				return 0;
+			}
+		}
+
+		if (timeout_in_ms < 0 || logger->next_config_check_in_ms - now < timeout_in_ms) {
+			timeout_in_ms = logger->next_config_check_in_ms - now;
+		}
+	}
+
+	return (int)timeout_in_ms;
+}
+
+/// @brief Do a single job of the housekeeping thread.
+static void _do_housekeeping_job(const HousekeepingJob *job) {
+	// room for the name of the job and a suffix
+	char file_name[FILE_NAME_LOG_ROTATION + 8];
+
+	switch (job->task) {
+		case HOUSEKEEPING_REMOVE_FILE:
+			remove(job->file_name);
+
+			if (job->compress) {
+				snprintf(file_name, sizeof(file_name), "%s.gz", job->file_name);
+				remove(file_name);
+			}
+			break;
+		case HOUSEKEEPING_SHIFT_ROTATED_FILES:
+			_shift_rotated_files(job->file_name, job->nbr_of_keeping_files, job->pending_name, job->compress);
+
+			if (job->compress) {
+				snprintf(file_name, sizeof(file_name), "%s.1", job->file_name);
+				_compress_file(file_name);
+			}
+			break;
+		case HOUSEKEEPING_COMPRESS_FILE:
+			_compress_file(job->file_name);
+			break;
+	}
+}
+
+/// @brief Hand over a job to the housekeeping thread. If no memory is left, then the job is done
+///        on the caller's thread instead.
+static void _add_housekeeping_job(const HousekeepingJob *job) {
+	HousekeepingJob *copy = malloc(sizeof(HousekeepingJob));
+
+	if (copy == NULL) {
+		_do_housekeeping_job(job);
+		return;
+	}
+
+	*copy = *job;
+	copy->next = NULL;
+
+	_lock_mutex(&_housekeeper.mutex);
+
+	if (_housekeeper.last_job == NULL) {
+		_housekeeper.first_job = copy;
+	} else {
+		_housekeeper.last_job->next = copy;
+	}
+
+	_housekeeper.last_job = copy;
+	_signal_condition(&_housekeeper.job_condition);
+	_unlock_mutex(&_housekeeper.mutex);
+}
+
+/// @brief Rotate the log file by NAMING_SEQUENCE: the current log file gets the next sequence number and
+///        only the rotated file, which is now out of nbr_of_keeping_files, is removed. The costs are
+///        the same for any number of keeping files.
+static void _rotate_log_files_by_sequence(Logger *logger) {
+	HousekeepingJob job = {.task = HOUSEKEEPING_REMOVE_FILE, .compress = logger->compress_rotated_files};
+	char rotated_name[FILE_NAME_LOG_ROTATION];
+	unsigned long long sequence = logger->next_sequence++;
+
+	snprintf(rotated_name, sizeof(rotated_name), "%s.%06llu", logger->log_file_to_use, sequence);
+
+	if (rename(logger->log_file_to_use, rotated_name) == 0 && logger->compress_rotated_files) {
+		HousekeepingJob compression = {.task = HOUSEKEEPING_COMPRESS_FILE};
+		snprintf(compression.file_name, sizeof(compression.file_name), "%s", rotated_name);
+		_add_housekeeping_job(&compression);
+	}
+
+	if (sequence < (unsigned long long)logger->nbr_of_keeping_files) {
+		return;
+	}
+
+	snprintf(job.file_name, sizeof(job.file_name), "%s.%06llu", logger->log_file_to_use, sequence - (unsigned long long)logger->nbr_of_keeping_files);
+
+	if (logger->background_housekeeping) {
+		_add_housekeeping_job(&job);
+	} else {
+		_do_housekeeping_job(&job);
+	}
+}
+
+/// @brief Initiate to rotate the log files. This happens for SIZE_ROTATION and DAILY_ROTATION.
+///
+///        A rotation to the next file, depending on the given nbr_of_keeping_files is going
+///        to do, if required. If the limitation has been reached, then the oldest file is
+///        going to overwrite.
+///
+///        With background housekeeping the current log file is only renamed here. Every other
+///        rename and remove is done by the housekeeping thread.
+static void _rotate_log_files(Logger *logger) {
+	if (logger->rotation_naming == NAMING_SEQUENCE) {
+		_rotate_log_files_by_sequence(logger);
+		return;
+	}
+
+	if (!logger->background_housekeeping) {
+		_shift_rotated_files(logger->log_file_to_use, logger->nbr_of_keeping_files, logger->log_file_to_use, false);
+		return;
+	}
+
+	// the current log file gets out of the way, the housekeeping thread makes it logfile.1 later
+	HousekeepingJob job = {
+		.task = HOUSEKEEPING_SHIFT_ROTATED_FILES,
+		.nbr_of_keeping_files = logger->nbr_of_keeping_files,
+		.compress = logger->compress_rotated_files
+	};
+
+	snprintf(job.file_name, sizeof(job.file_name), "%s", logger->log_file_to_use);
+	snprintf(job.pending_name, sizeof(job.pending_name), "%s.pending%llu", logger->log_file_to_use, logger->next_pending_file++);
+
+	if (rename(logger->log_file_to_use, job.pending_name) == 0) {
+		_add_housekeeping_job(&job);
+	}
+
+	// Now a new log file can be created as log_file_to_use (e.g., logfile.log)
+}
+
+#ifdef LOG_WITH_IO_URING
+/// @brief Release every resource of an io_uring instance. Every write must be completed before.
+static void _destroy_ring(struct LogRing *ring) {
+	if (ring->sqes != NULL) {
+		munmap(ring->sqes, ring->sqes_size);
+	}
+
+	if (ring->cq_ring != NULL && ring->cq_ring != ring->sq_ring) {
+		munmap(ring->cq_ring, ring->cq_ring_size);
+	}
+
+	if (ring->sq_ring != NULL) {
+		munmap(ring->sq_ring, ring->sq_ring_size);
+	}
+
+	// closing the ring unregisters the batches, too
+	if (ring->ring_fd >= 0) {
+		close(ring->ring_fd);
+	}
+
+	free(ring->memory);
+	free(ring);
+}
+
+/// @brief Map a part of an io_uring instance into the memory.
+/// @return the mapped memory or NULL
+static void *_map_ring(int ring_fd, size_t size, off_t offset) {
+	void *data = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, offset);
+	return data == MAP_FAILED ? NULL : data;
+}
+
+/// @brief Check by IORING_REGISTER_PROBE, if the kernel does the writes of the batches. IORING_OP_WRITE, IOSQE_ASYNC and
+///        the probe itself have been added with Linux 5.6, so an older kernel fails the probe.
+/// @return true, if IORING_OP_WRITE and IORING_OP_WRITE_FIXED are supported
+static bool _is_ring_write_supported(int ring_fd) {
+	struct io_uring_probe *probe = calloc(1, sizeof(struct io_uring_probe) + IORING_OP_LAST * sizeof(struct io_uring_probe_op));
+	bool supported = probe != NULL &&
+		syscall(__NR_io_uring_register, ring_fd, IORING_REGISTER_PROBE, probe, IORING_OP_LAST) == 0 &&
+		probe->last_op >= IORING_OP_WRITE &&
+		(probe->ops[IORING_OP_WRITE].flags & IO_URING_OP_SUPPORTED) != 0 &&
+		(probe->ops[IORING_OP_WRITE_FIXED].flags & IO_URING_OP_SUPPORTED) != 0;
+
+	free(probe);
+	return supported;
+}
+
+/// @brief Create an io_uring instance with LOG_RING_BATCHES batches of the given size.
+/// @param batch_capacity size of each batch in bytes
+/// @return the io_uring instance or NULL, if io_uring isn't available, e.g. an older kernel without IORING_OP_WRITE
+///         or a seccomp filter
+static struct LogRing *_create_ring(size_t batch_capacity) {
+	struct LogRing *ring = calloc(1, sizeof(struct LogRing));
+
+	if (ring == NULL) {
+		return NULL;
+	}
+
+	struct io_uring_params params;
+	memset(&params, 0, sizeof(params));
+
+	ring->ring_fd = (int)syscall(__NR_io_uring_setup, 2 * LOG_RING_BATCHES, &params);
+	ring->memory = malloc(LOG_RING_BATCHES * batch_capacity);
+
+	if (ring->ring_fd < 0 || ring->memory == NULL || !_is_ring_write_supported(ring->ring_fd)) {
+		_destroy_ring(ring);
+		return NULL;
+	}
+
+	ring->sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+	ring->cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+	ring->sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+
+	if (params.features & IORING_FEAT_SINGLE_MMAP) {
+		// both queues are in a single mapping
+		ring->sq_ring_size = ring->sq_ring_size > ring->cq_ring_size ? ring->sq_ring_size : ring->cq_ring_size;
+		ring->sq_ring = _map_ring(ring->ring_fd, ring->sq_ring_size, IORING_OFF_SQ_RING);
+		ring->cq_ring = ring->sq_ring;
+	} else {
+		ring->sq_ring = _map_ring(ring->ring_fd, ring->sq_ring_size, IORING_OFF_SQ_RING);
+		ring->cq_ring = _map_ring(ring->ring_fd, ring->cq_ring_size, IORING_OFF_CQ_RING);
+	}
+
+	ring->sqes = _map_ring(ring->ring_fd, ring->sqes_size, IORING_OFF_SQES);
+
+	if (ring->sq_ring == NULL || ring->cq_ring == NULL || ring->sqes == NULL) {
+		_destroy_ring(ring);
+		return NULL;
+	}
+
+	ring->sq_tail = (unsigned *)((char *)ring->sq_ring + params.sq_off.tail);
+	ring->sq_mask = (unsigned *)((char *)ring->sq_ring + params.sq_off.ring_mask);
+	ring->sq_array = (unsigned *)((char *)ring->sq_ring + params.sq_off.array);
+	ring->cq_head = (unsigned *)((char *)ring->cq_ring + params.cq_off.head);
+	ring->cq_tail = (unsigned *)((char *)ring->cq_ring + params.cq_off.tail);
+	ring->cq_mask = (unsigned *)((char *)ring->cq_ring + params.cq_off.ring_mask);
+	ring->cqes = (struct io_uring_cqe *)((char *)ring->cq_ring + params.cq_off.cqes);
+
+	struct iovec buffers[LOG_RING_BATCHES];
+
+	for (int i = 0; i < LOG_RING_BATCHES; i++) {
+		ring->batches[i] = ring->memory + (size_t)i * batch_capacity;
+		buffers[i].iov_base = ring->batches[i];
+		buffers[i].iov_len = batch_capacity;
+	}
+
+	// an older kernel counts registered buffers against RLIMIT_MEMLOCK; without them each write maps the batch again
+	ring->registered = syscall(__NR_io_uring_register, ring->ring_fd, IORING_REGISTER_BUFFERS, buffers, LOG_RING_BATCHES) == 0;
+	ring->file_descriptor = -1;
+	return ring;
+}
+
+/// @brief Write data at a given position of the log file of the batches on the caller's thread.
+/// @return number of written bytes
+static size_t _write_ring_file_at(struct LogRing *ring, const char *data, size_t length, long long offset) {
+	size_t written = 0;
+
+	while (written < length) {
+		ssize_t result = pwrite(ring->file_descriptor, data + written, length - written, (off_t)(offset + (long long)written));
+
+		if (result < 0 && errno == EINTR) {
+			continue;
+		}
+
+		if (result <= 0) {
+			fprintf(stderr, "%sERROR: unable to write the log file...%s: %s\n", _level_colors[4], COLOR_RESET, strerror(errno));
+			break;
+		}
+
+		written += (size_t)result;
+	}
+
+	return written;
+}
+
+/// @brief Write the rest of a batch on the caller's thread. Only in use, if the kernel doesn't take a write.
+static void _write_ring_batch_directly(struct LogRing *ring, int index) {
+	_write_ring_file_at(
+		ring, ring->batches[index] + ring->written[index], ring->lengths[index] - ring->written[index],
+		ring->offsets[index] + (long long)ring->written[index]
+	);
+
+	ring->written[index] = ring->lengths[index];
+}
+
+/// @brief Write a log line, which is longer than a whole batch, behind the submitted batches on the caller's thread.
+///        The file position of the FILE isn't in use, since the log file has no O_APPEND, see: _attach_ring_file()
+///
+///        NOTE: The caller must hold the file_mutex.
+/// @return number of written bytes
+static size_t _write_ring_line_directly(struct LogRing *ring, const char *line, size_t length) {
+	long long offset = ring->file_offset;
+	ring->file_offset += (long long)length;
+	return _write_ring_file_at(ring, line, length, offset);
+}
+
+/// @brief Put a write of the rest of a batch into the submission queue and hand it over to the kernel.
+///        With IOSQE_ASYNC a worker thread of the kernel does the write, so the caller only pays for the system call.
+/// @return true, if the kernel has taken the write, otherwise false
+static bool _submit_ring_write(struct LogRing *ring, int index) {
+	unsigned tail = *ring->sq_tail;
+	unsigned slot = tail & *ring->sq_mask;
+	struct io_uring_sqe *sqe = &ring->sqes[slot];
+
+	memset(sqe, 0, sizeof(*sqe));
+	sqe->opcode = ring->registered ? IORING_OP_WRITE_FIXED : IORING_OP_WRITE;
+	sqe->flags = IOSQE_ASYNC;
+	sqe->fd = ring->file_descriptor;
+	sqe->addr = (unsigned long long)(size_t)(ring->batches[index] + ring->written[index]);
+	sqe->len = (unsigned)(ring->lengths[index] - ring->written[index]);
+	sqe->off = (unsigned long long)(ring->offsets[index] + (long long)ring->written[index]);
+	sqe->buf_index = (unsigned short)index;
+	sqe->user_data = (unsigned long long)index;
+	ring->sq_array[slot] = slot;
+
+	// the kernel must see the complete entry before the new tail
+	atomic_store_explicit((atomic_uint *)ring->sq_tail, tail + 1, memory_order_release);
+
+	for (;;) {
+		long submitted = syscall(__NR_io_uring_enter, ring->ring_fd, 1, 0, 0, NULL, 0);
+
+		if (submitted == 1) {
+			return true;
+		}
+
+		if (submitted < 0 && errno == EINTR) {
+			continue;
+		}
+
+		// the kernel hasn't taken the entry, so it's removed again
+		atomic_store_explicit((atomic_uint *)ring->sq_tail, tail, memory_order_release);
+		return false;
+	}
+}
+
+/// @brief Take every completed write from the completion queue. The rest of a short write is submitted again.
+///        The rest of a failed write is written on the caller's thread, which reports its own error.
+/// @param wait if set and no write has been completed yet, then it waits for the next completion
+static void _reap_ring_completions(struct LogRing *ring, bool wait) {
+	unsigned head = *ring->cq_head;
+
+	if (wait && head == atomic_load_explicit((atomic_uint *)ring->cq_tail, memory_order_acquire)) {
+		// an interrupted wait just returns, the caller asks again
+		syscall(__NR_io_uring_enter, ring->ring_fd, 0, 1, IORING_ENTER_GETEVENTS, NULL, 0);
+	}
+
+	unsigned tail = atomic_load_explicit((atomic_uint *)ring->cq_tail, memory_order_acquire);
+
+	for (; head != tail; head++) {
+		struct io_uring_cqe *cqe = &ring->cqes[head & *ring->cq_mask];
+		int index = (int)cqe->user_data;
+
+		// a write is canceled, if the thread, which has submitted it, has been finished in the meantime;
+		// each batch has its own position in the log file, so it's just submitted again
+		bool failed = cqe->res <= 0 && cqe->res != -EINTR && cqe->res != -EAGAIN && cqe->res != -ECANCELED;
+
+		if (cqe->res > 0) {
+			ring->written[index] += (size_t)cqe->res;
+		}
+
+		if (!failed && ring->written[index] < ring->lengths[index] && _submit_ring_write(ring, index)) {
+			continue;
+		}
+
+		_write_ring_batch_directly(ring, index);
+		ring->in_flight[index] = false;
+		ring->nbr_in_flight--;
+	}
+
+	atomic_store_explicit((atomic_uint *)ring->cq_head, head, memory_order_release);
+}
+
+/// @brief Wait, until every batch has been written into the log file.
+static void _wait_for_ring(struct LogRing *ring) {
+	while (ring->nbr_in_flight > 0) {
+		_reap_ring_completions(ring, true);
+	}
+}
+
+/// @brief Prepare a new opened log file for the batches. Each batch is written at its own position,
+///        which doesn't work with O_APPEND, so the position is counted from the end of the file on.
+static void _attach_ring_file(struct LogRing *ring, FILE *file) {
+	int file_descriptor = fileno(file);
+	int flags = fcntl(file_descriptor, F_GETFL);
+	struct stat st;
+
+	if (flags >= 0) {
+		fcntl(file_descriptor, F_SETFL, flags & ~O_APPEND);
+	}
+
+	ring->file_descriptor = file_descriptor;
+	ring->file_offset = fstat(file_descriptor, &st) == 0 ? (long long)st.st_size : 0;
+}
+
+/// @brief Hand over the filled batch to the kernel and continue with the next batch. Only waits,
+///        if the kernel is still writing the next batch.
+///
+///        NOTE: The caller must hold the file_mutex.
+static void _submit_ring_batch(Logger *logger) {
+	struct LogRing *ring = logger->ring;
+	int index = ring->current;
+
+	ring->lengths[index] = logger->batch_length;
+	ring->written[index] = 0;
+	ring->offsets[index] = ring->file_offset;
+	ring->file_offset += (long long)logger->batch_length;
+
+	if (_submit_ring_write(ring, index)) {
+		ring->in_flight[index] = true;
+		ring->nbr_in_flight++;
+	} else {
+		_write_ring_batch_directly(ring, index);
+	}
+
+	ring->current = (index + 1) % LOG_RING_BATCHES;
+	_reap_ring_completions(ring, false);
+
+	while (ring->in_flight[ring->current]) {
+		_reap_ring_completions(ring, true);
+	}
+
+	logger->batch_buffer = ring->batches[ring->current];
+}
+#endif
+
+/// @brief Reserve the disk space of a whole log file for SIZE_ROTATION at once, so appending doesn't
+///        need a new block with each few log events. The file size itself isn't changed, so the log
+///        file is still appended as usual. Only available on Linux (fallocate) and Windows.
+static void _preallocate_log_file(Logger *logger) {
+	#if defined(_WIN32)
+	FILE_ALLOCATION_INFO allocation;
+	allocation.AllocationSize.QuadPart = logger->size_for_file_size;
+	HANDLE file = (HANDLE)_get_osfhandle(_fileno(logger->log_file_pointer));
+	SetFileInformationByHandle(file, FileAllocationInfo, &allocation, sizeof(allocation));
+	#elif defined(__linux__)
+	// a file system without support just leaves the file as it is
+	fallocate(fileno(logger->log_file_pointer), FALLOC_FL_KEEP_SIZE, 0, (off_t)logger->size_for_file_size);
+	#endif
+
+	logger->file_preallocated = true;
+}
+
+/// @brief Open the log file to use in append mode, if it isn't already open.
+/// @return true, if a valid file pointer exists, otherwise false
+static bool _open_log_file(Logger *logger) {
+	if (logger->log_file_pointer == NULL) {
+		logger->log_file_pointer = fopen(logger->log_file_to_use, "a");
+
+		// the batch is already collected, so each fwrite() turns into a single write() without another copy
+		if (logger->log_file_pointer != NULL && logger->batch_buffer != NULL) {
+			setvbuf(logger->log_file_pointer, NULL, _IONBF, 0);
+		}
+
+		// only once for each log file, even if it's opened and closed for each log event
+		if (logger->log_file_pointer != NULL && logger->preallocate_files && !logger->file_preallocated) {
+			_preallocate_log_file(logger);
+		}
+
+		// a new binary log file starts with LOG_BINARY_MAGIC, an existing one is just continued
+		struct stat st;
+
+		if (
+			logger->log_file_pointer != NULL && logger->binary_formats != NULL &&
+			fstat(fileno(logger->log_file_pointer), &st) == 0 && st.st_size == 0
+		) {
+			fwrite(LOG_BINARY_MAGIC, 1, sizeof(LOG_BINARY_MAGIC) - 1, logger->log_file_pointer);
+			fflush(logger->log_file_pointer);
+		}
+
+		#ifdef LOG_WITH_IO_URING
+		if (logger->log_file_pointer != NULL && logger->ring != NULL) {
+			_attach_ring_file(logger->ring, logger->log_file_pointer);
+		}
+		#endif
+	}
+
+	return logger->log_file_pointer != NULL;
+}
+
+/// @brief Close the log file, if it's open. Any buffered log event is going to write before.
+static void _close_log_file(Logger *logger) {
+	if (logger->log_file_pointer != NULL) {
+		#ifdef LOG_WITH_IO_URING
+		// the kernel may still write batches into the log file
+		if (logger->ring != NULL) {
+			_wait_for_ring(logger->ring);
+		}
+		#endif
+
+		fclose(logger->log_file_pointer);
+		logger->log_file_pointer = NULL;
+	}
+}
+
+/// @brief Cut the preallocated disk space of the current log file to its real length. Does nothing,
+///        if the current log file hasn't been preallocated. The caller closes the log file afterwards.
+static void _release_preallocation(Logger *logger) {
+	if (!logger->file_preallocated || !_open_log_file(logger)) {
+		return;
+	}
+
+	#if defined(_WIN32)
+	HANDLE file = (HANDLE)_get_osfhandle(_fileno(logger->log_file_pointer));
+	FILE_ALLOCATION_INFO allocation;
+
+	if (GetFileSizeEx(file, &allocation.AllocationSize)) {
+		SetFileInformationByHandle(file, FileAllocationInfo, &allocation, sizeof(allocation));
+	}
+	#elif defined(__linux__)
+	// a truncate to the same length releases every block behind the end of the file
+	struct stat st;
+	fflush(logger->log_file_pointer);
+
+	#ifdef LOG_WITH_IO_URING
+	if (logger->ring != NULL) {
+		_wait_for_ring(logger->ring);
+	}
+	#endif
+
+	if (fstat(fileno(logger->log_file_pointer), &st) == 0 && ftruncate(fileno(logger->log_file_pointer), st.st_size) != 0) {
+		fprintf(stderr, "%sERROR: unable to release the preallocated space of the log file: %s%s\n", _level_colors[4], strerror(errno), COLOR_RESET);
+	}
+	#endif
+
+	logger->file_preallocated = false;
+}
+
+/// @brief Determine the point in time, when the day after the given timestamp begins (local time).
+/// @param since the timestamp to start from
+/// @return the beginning of the next day
+static time_t _determine_next_day_boundary(time_t since) {
+	struct tm since_tm;
+
+	if (_on_safe_localtime(&since, &since_tm) != 0) {
+		// fallback: at least one rotation per day
+		return since + 24 * 60 * 60;
+	}
+
+	since_tm.tm_hour = 0;
+	since_tm.tm_min = 0;
+	since_tm.tm_sec = 0;
+	since_tm.tm_mday += 1;                       // mktime() normalizes the end of a month or a year
+	since_tm.tm_isdst = -1;
+
+	return mktime(&since_tm);
+}
+
+#ifdef _WIN32
+// special case(s) for Windows systems only
+
+/// @brief Create an error message depending on known error number. Since this comes from
+///        the Windows API, a standard function, like strerror(errno) can't be used here.
+///        Furthermore this function shall also be available for threading.
+///
+///        The error message points to the address of a dynamic C-string. If this doesn't
+///        points to NULL after the function call, this which MUST be freed after its usage.
+///        This can be realized with LocalFree() function.
+/// @param error_number the detected error number
+/// @param error_message the address for the error message
+void _generate_last_error_message(DWORD error_number, char **error_message) {
+	FormatMessageA(
+		FORMAT_MESSAGE_ALLOCATE_BUFFER | FORMAT_MESSAGE_FROM_SYSTEM | FORMAT_MESSAGE_IGNORE_INSERTS,    // dwflags
+		NULL,                                                                                           // lpSource
+		error_number,                                                                                   // dwMEssageId
+		0,                                                                                              // dwLanguageId
+		(LPSTR) error_message,                                                                          // lpBuffer
+		0,                                                                                              // nSize
+		NULL                                                                                            // Arguments
+	);
+}
+#endif
+
+/// @brief Check, if a file name in the directory of the log file is a rotated file by NAMING_SEQUENCE,
+///        like "output.log.000123" or the compressed "output.log.000123.gz".
+/// @param entry_name file name without any directory
+/// @param base_name name of the log file without any directory
+/// @param sequence the sequence number of the rotated file
+/// @return true, if it's a rotated file, otherwise false
+static bool _parse_sequence_file_name(const char *entry_name, const char *base_name, unsigned long long *sequence) {
+	size_t base_length = strlen(base_name);
+
+	if (strncmp(entry_name, base_name, base_length) != 0 || entry_name[base_length] != '.') {
+		return false;
+	}
+
+	const char *digits = entry_name + base_length + 1;
+	size_t nbr_of_digits = strspn(digits, "0123456789");
+
+	if (nbr_of_digits == 0 || (digits[nbr_of_digits] != '\0' && strcmp(digits + nbr_of_digits, ".gz") != 0)) {
+		return false;
+	}
+
+	*sequence = strtoull(digits, NULL, 10);
+	return true;
+}
+
+/// @brief Look once into the directory of the log file for rotated files by NAMING_SEQUENCE.
+/// @param remove_below every rotated file with a lower sequence number is removed; 0 removes nothing
+/// @return the highest sequence number + 1 or 0, if no rotated file exists
+static unsigned long long _scan_sequence_files(Logger *logger, unsigned long long remove_below) {
+	char rotated_name[FILE_NAME_LOG_ROTATION];
+	unsigned long long next_sequence = 0;
+	unsigned long long sequence;
+
+	// the log file name may contain a directory
+	const char *base_name = logger->log_file_to_use;
+
+	for (const char *c = logger->log_file_to_use; *c != '\0'; c++) {
+		if (*c == '/' || *c == '\\') {
+			base_name = c + 1;
+		}
+	}
+
+	#ifdef _WIN32
+	// only for Windows
+	WIN32_FIND_DATAA entry;
+	snprintf(rotated_name, sizeof(rotated_name), "%s.*", logger->log_file_to_use);
+	HANDLE search = FindFirstFileA(rotated_name, &entry);
+
+	if (search == INVALID_HANDLE_VALUE) {
+		return 0;
+	}
+
+	do {
+		if (!_parse_sequence_file_name(entry.cFileName, base_name, &sequence)) {
+			continue;
+		}
+	#else
+	// for UNIX systems only
+	char directory_name[FILE_NAME_LOG_ROTATION] = ".";
+
+	if (base_name != logger->log_file_to_use) {
+		snprintf(directory_name, sizeof(directory_name), "%.*s", (int)(base_name - logger->log_file_to_use), logger->log_file_to_use);
+	}
+
+	DIR *directory = opendir(directory_name);
+
+	if (directory == NULL) {
+		return 0;
+	}
+
+	struct dirent *entry;
+
+	while ((entry = readdir(directory)) != NULL) {
+		if (!_parse_sequence_file_name(entry->d_name, base_name, &sequence)) {
+			continue;
+		}
+	#endif
+
+		if (sequence < remove_below) {
+			snprintf(rotated_name, sizeof(rotated_name), "%s.%06llu", logger->log_file_to_use, sequence);
+			remove(rotated_name);
+
+			snprintf(rotated_name, sizeof(rotated_name), "%s.%06llu.gz", logger->log_file_to_use, sequence);
+			remove(rotated_name);
+		} else if (sequence + 1 > next_sequence) {
+			next_sequence = sequence + 1;
+		}
+
+	#ifdef _WIN32
+	} while (FindNextFileA(search, &entry));
+
+	FindClose(search);
+	#else
+	}
+
+	closedir(directory);
+	#endif
+
+	return next_sequence;
+}
+
+/// @brief Seed the in-memory rotation state by one look to the current log file. Only in use, if
+///        DAILY_ROTATION or SIZE_ROTATION is set. After that every rotation decision is made
+///        without any further file system access.
+///
+///        If the log file doesn't exist yet, then a new and empty log file is assumed.
+static void _seed_rotation_state(Logger *logger) {
+	long long file_size = 0;
+	time_t creation_time = time(NULL);
+
+	#ifdef _WIN32
+	// only for Windows
+	WIN32_FILE_ATTRIBUTE_DATA fileInfo;
+
+	if (GetFileAttributesEx(logger->log_file_to_use, GetFileExInfoStandard, &fileInfo)) {
+		// file size in bytes
+		LARGE_INTEGER size;
+		size.HighPart = fileInfo.nFileSizeHigh;
+		size.LowPart = fileInfo.nFileSizeLow;
+		file_size = (long long)size.QuadPart;
+
+		// file creation time: 100ns intervals since January 1st, 1601 => seconds since January 1st, 1970
+		ULARGE_INTEGER creation;
+		creation.HighPart = fileInfo.ftCreationTime.dwHighDateTime;
+		creation.LowPart = fileInfo.ftCreationTime.dwLowDateTime;
+		creation_time = (time_t)((creation.QuadPart - 116444736000000000ULL) / 10000000ULL);
+	} else {
+		DWORD last_error = GetLastError();
+
+		if (last_error != ERROR_FILE_NOT_FOUND) {
+			char *error_message = NULL;
+			_generate_last_error_message(last_error, &error_message);
+
+			if (error_message != NULL) {
+				fprintf(stderr, "%sERROR: Could not get file attributes: %s%s\n", _level_colors[4], error_message, COLOR_RESET);
+				LocalFree(error_message);
+			} else {
+				fprintf(stderr, "%sERROR: Could not get file attributes. (error id: %lu)%s\n", _level_colors[4], last_error, COLOR_RESET);
+			}
+		}
+	}
+
+	#else
+	// for UNIX systems only
+	struct stat st;
+
+	if (stat(logger->log_file_to_use, &st) == 0) {
+		file_size = (long long)st.st_size;
+
+		// NOTE: the POSIX creation time might not be available on all UNIX systems,
+		//       in that case the modification time is used as a fallback
+		#if defined(__APPLE__) || defined(_MAC)
+			creation_time = st.st_birthtime;
+		#elif defined(_BSD_SOURCE) || defined(__FreeBSD__)
+			creation_time = st.st_ctimespec.tv_sec;
+		#else
+			creation_time = st.st_mtime;
+		#endif
+	} else if (errno != ENOENT) {
+		fprintf(stderr, "%sERROR: Unable to use stat for current file: %s%s\n", _level_colors[4], strerror(errno), COLOR_RESET);
+	}
+	#endif
+
+	logger->bytes_in_current_file = file_size;
+	logger->next_day_boundary = _determine_next_day_boundary(creation_time);
+
+	if (logger->rotation_naming == NAMING_SEQUENCE) {
+		// rotated files from a previous log session, which are out of nbr_of_keeping_files, are removed once here
+		logger->next_sequence = _scan_sequence_files(logger, 0);
+
+		if (logger->next_sequence > (unsigned long long)logger->nbr_of_keeping_files) {
+			_scan_sequence_files(logger, logger->next_sequence - (unsigned long long)logger->nbr_of_keeping_files);
+		}
+	}
+}
+
+/// @brief Check, if a file needs a rotation. Only in use, if DAILY_ROTATION or
+///        SIZE_ROTATION is set. In both cases the Logging.nbr_of_keeping_files is in use.
+///        The decision is made by the in-memory state from _seed_rotation_state() only.
+///
+///        SIZE_ROTATION: If the certain Logging.file_size_in_mb has exceeds the limit,
+///        mark for a rotation.
+///
+///        DAILY_ROTATION: If a new day starts, mark for a rotation.
+/// @return true, if a rotation is required, otherwise false
+static bool _check_for_new_rotation(Logger *logger) {
+	if (logger->log_rotation == SIZE_ROTATION) {
+		return logger->bytes_in_current_file >= logger->size_for_file_size;
+	}
+
+	if (logger->log_rotation == DAILY_ROTATION) {
+		return time(NULL) >= logger->next_day_boundary;
+	}
+
+	return false;
+}
+
+/// @brief Release the buffers for long log messages of the current thread.
+static void _release_thread_buffers(void) {
+	free(_long_message_buffer.data);
+	free(_long_line_buffer.data);
+	free(_fields_text_buffer.data);
+	_long_message_buffer = (ThreadBuffer){0};
+	_long_line_buffer = (ThreadBuffer){0};
+	_fields_text_buffer = (ThreadBuffer){0};
+}
+
+/// @brief Destructor of the key of the thread buffers: a thread, which ends, releases its buffers. It's registered
+///        again, if it logs a long log message in another destructor afterwards.
+#ifdef _WIN32
+static VOID WINAPI _on_thread_buffers_exit(PVOID value) {
+#else
+static void _on_thread_buffers_exit(void *value) {
+#endif
+	(void)value;
+	_release_thread_buffers();
+	_thread_buffers_registered = false;
+}
+
+/// @brief Create the key of the thread buffers once for the whole process.
+#ifdef _WIN32
+static BOOL CALLBACK _create_thread_buffers_key(PINIT_ONCE once, PVOID parameter, PVOID *context) {
+	(void)once;
+	(void)parameter;
+	(void)context;
+	_thread_buffers_key = FlsAlloc(_on_thread_buffers_exit);
+	return TRUE;
+}
+#else
+static void _create_thread_buffers_key(void) {
+	_thread_buffers_key_created = pthread_key_create(&_thread_buffers_key, _on_thread_buffers_exit) == 0;
+}
+#endif
+
+/// @brief Register the current thread once, so its buffers are released, when it ends. Otherwise every thread, which
+///        has logged a long log message, would keep its buffers after its end. dispose() only releases the ones of its
+///        own thread.
+static void _register_thread_buffers(void) {
+	if (_thread_buffers_registered) {
+		return;
+	}
+
+	_thread_buffers_registered = true;
+
+	// only a value other than NULL calls the destructor
+	#ifdef _WIN32
+	InitOnceExecuteOnce(&_thread_buffers_key_once, _create_thread_buffers_key, NULL, NULL);
+
+	if (_thread_buffers_key != FLS_OUT_OF_INDEXES) {
+		FlsSetValue(_thread_buffers_key, &_thread_buffers_registered);
+	}
+	#else
+	pthread_once(&_thread_buffers_key_once, _create_thread_buffers_key);
+
+	if (_thread_buffers_key_created) {
+		pthread_setspecific(_thread_buffers_key, &_thread_buffers_registered);
+	}
+	#endif
+}
+
+/// @brief Make sure, that a buffer of the current thread has at least the given size.
+///        The buffer only grows and is reused by following log events.
+/// @param buffer the buffer of the current thread
+/// @param size required number of characters
+/// @return the buffer or NULL, if no memory is left
+static char *_reserve_thread_buffer(ThreadBuffer *buffer, size_t size) {
+	if (buffer->capacity < size) {
+		_register_thread_buffers();
+
+		size_t capacity = buffer->capacity * 2 > size ? buffer->capacity * 2 : size;
+		char *data = realloc(buffer->data, capacity);
+
+		if (data == NULL) {
+			return NULL;
+		}
+
+		buffer->data = data;
+		buffer->capacity = capacity;
+	}
+
+	return buffer->data;
+}
+
+/// @brief Put a complete log line together: "[timestamp] [LEVEL] message\n". For console output the
+///        level is colorized. The parts are only copied, so nothing is formatted a second time.
+/// @param line destination with at least LENGTH_LOG_LINE_OVERHEAD + message_length characters
+/// @param timestamp timestamp of the log event
+/// @param level current log level
+/// @param message the formatted log message
+/// @param message_length number of characters of message
+/// @param colorized true, if the level shall be colorized for a console
+/// @return number of characters of the log line without the null terminator
+static size_t _compose_log_line(char *line, const char *timestamp, LogLevel level, const char *message, size_t message_length, bool colorized) {
+	size_t length = 0;
+
+	#define APPEND_TO_LINE(text, text_length) do { memcpy(line + length, (text), (text_length)); length += (text_length); } while (0)
+
+	const char *level_string = _log_level_to_string(level);
+	const char *level_color = _level_colors[level >= LOG_TRACE && level <= LOG_FATAL ? level : LOG_INFO];
+
+	APPEND_TO_LINE("[", 1);
+	APPEND_TO_LINE(timestamp, strlen(timestamp));
+	APPEND_TO_LINE("] ", 2);
+
+	if (colorized) {
+		APPEND_TO_LINE(level_color, strlen(level_color));
+	}
+
+	APPEND_TO_LINE("[", 1);
+	APPEND_TO_LINE(level_string, strlen(level_string));
+	APPEND_TO_LINE("]", 1);
+
+	if (colorized) {
+		APPEND_TO_LINE(COLOR_RESET, sizeof(COLOR_RESET) - 1);
+	}
+
+	APPEND_TO_LINE(" ", 1);
+	APPEND_TO_LINE(message, message_length);
+	APPEND_TO_LINE("\n", 1);
+
+	#undef APPEND_TO_LINE
+
+	line[length] = '\0';
+	return length;
+}
+
+/// @brief Escape a string for JSON: '"', '\\' and the control characters below 0x20 are escaped, every other
+///        byte (e.g. UTF-8) is copied as it is. With SSE2 16 characters are checked at once, so a log message
+///        without any special character is only copied.
+/// @param destination buffer with at least LENGTH_JSON_ESCAPED(length) characters; not null terminated
+/// @param text the string to escape
+/// @param length number of characters of text
+/// @return number of characters of the escaped string
+static size_t _escape_json_string(char *destination, const char *text, size_t length) {
+	static const char hex_digits[] = "0123456789abcdef";
+	size_t written = 0;
+	size_t i = 0;
+
+	#ifdef LOG_WITH_SSE2
+	const __m128i quote = _mm_set1_epi8('"');
+	const __m128i backslash = _mm_set1_epi8('\\');
+	const __m128i control = _mm_set1_epi8(0x1f);
+	#endif
+
+	while (i < length) {
+		size_t end = length;
+
+		#ifdef LOG_WITH_SSE2
+		if (length - i >= 16) {
+			__m128i chunk = _mm_loadu_si128((const __m128i *)(text + i));
+
+			// max(c, 0x1f) is 0x1f for the control characters only, even for bytes above 0x7f
+			__m128i special = _mm_or_si128(
+				_mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash)),
+				_mm_cmpeq_epi8(_mm_max_epu8(chunk, control), control)
+			);
+
+			if (_mm_movemask_epi8(special) == 0) {
+				_mm_storeu_si128((__m128i *)(destination + written), chunk);
+				written += 16;
+				i += 16;
+				continue;
+			}
+
+			// at least one of the 16 characters must be escaped
+			end = i + 16;
+		}
+		#endif
+
+		for (; i < end; i++) {
+			unsigned char c = (unsigned char)text[i];
+
+			if (c >= 0x20 && c != '"' && c != '\\') {
+				destination[written++] = (char)c;
+				continue;
+			}
+
+			destination[written++] = '\\';
+
+			switch (c) {
+				case '"':
+				case '\\':
+					destination[written++] = (char)c;
+					break;
+				case '\n':
+					destination[written++] = 'n';
+					break;
+				case '\r':
+					destination[written++] = 'r';
+					break;
+				case '\t':
+					destination[written++] = 't';
+					break;
+				case '\b':
+					destination[written++] = 'b';
+					break;
+				case '\f':
+					destination[written++] = 'f';
+					break;
+				default:
+					memcpy(destination + written, "u00", 3);
+					destination[written + 3] = hex_digits[c >> 4];
+					destination[written + 4] = hex_digits[c & 0x0f];
+					written += 5;
+					break;
+			}
+		}
+	}
+
+	return written;
+}
+
+/// @brief Number of characters of the fields of a log event at most, in the text form and as JSON members.
+/// @param fields key and value for each field
+/// @param nbr_of_fields number of pairs in fields
+static size_t _fields_capacity(const char *const *fields, size_t nbr_of_fields) {
+	size_t capacity = 0;
+
+	for (size_t i = 0; i < nbr_of_fields * 2; i++) {
+		// quotes and separators included
+		capacity += LENGTH_JSON_ESCAPED(strlen(fields[i])) + 4;
+	}
+
+	return capacity;
+}
+
+/// @brief Append the fields of a log event in the text form: key="value" for each field with a leading space.
+///        Keys and values are escaped like JSON strings, so a field can't break the log line.
+/// @param destination buffer with at least _fields_capacity() characters; not null terminated
+/// @param fields key and value for each field
+/// @param nbr_of_fields number of pairs in fields
+/// @return number of appended characters
+static size_t _append_text_fields(char *destination, const char *const *fields, size_t nbr_of_fields) {
+	size_t length = 0;
+
+	for (size_t i = 0; i < nbr_of_fields; i++) {
+		destination[length++] = ' ';
+		length += _escape_json_string(destination + length, fields[i * 2], strlen(fields[i * 2]));
+		destination[length++] = '=';
+		destination[length++] = '"';
+		length += _escape_json_string(destination + length, fields[i * 2 + 1], strlen(fields[i * 2 + 1]));
+		destination[length++] = '"';
+	}
+
+	return length;
+}
+
+/// @brief Put a complete JSON line together for Logging.json_lines:
+///        {"time":"timestamp","level":"LEVEL","message":"message","key":"value"}\n
+/// @param line destination with at least LENGTH_JSON_LINE_OVERHEAD + LENGTH_JSON_ESCAPED(message_length) + _fields_capacity() characters
+/// @param timestamp timestamp of the log event
+/// @param level current log level
+/// @param message the formatted log message
+/// @param message_length number of characters of message
+/// @param fields key and value for each field
+/// @param nbr_of_fields number of pairs in fields
+/// @return number of characters of the JSON line without the null terminator
+static size_t _compose_json_line(char *line, const char *timestamp, LogLevel level, const char *message, size_t message_length, const char *const *fields, size_t nbr_of_fields) {
+	size_t length = 0;
+
+	#define APPEND_TO_LINE(text, text_length) do { memcpy(line + length, (text), (text_length)); length += (text_length); } while (0)
+
+	const char *level_string = _log_level_to_string(level);
+
+	APPEND_TO_LINE("{\"time\":\"", 9);
+	APPEND_TO_LINE(timestamp, strlen(timestamp));
+	APPEND_TO_LINE("\",\"level\":\"", 11);
+	APPEND_TO_LINE(level_string, strlen(level_string));
+	APPEND_TO_LINE("\",\"message\":\"", 13);
+	length += _escape_json_string(line + length, message, message_length);
+	APPEND_TO_LINE("\"", 1);
+
+	for (size_t i = 0; i < nbr_of_fields; i++) {
+		APPEND_TO_LINE(",\"", 2);
+		length += _escape_json_string(line + length, fields[i * 2], strlen(fields[i * 2]));
+		APPEND_TO_LINE("\":\"", 3);
+		length += _escape_json_string(line + length, fields[i * 2 + 1], strlen(fields[i * 2 + 1]));
+		APPEND_TO_LINE("\"", 1);
+	}
+
+	APPEND_TO_LINE("}\n", 2);
+
+	#undef APPEND_TO_LINE
+
+	line[length] = '\0';
+	return length;
+}
+
+/// @brief Put the log line of a log event together: a JSON line for Logging.json_lines, otherwise a text line
+///        with the fields behind the log message. The log line is composed in stack_line, if it fits, otherwise
+///        in the buffer of the current thread. If no memory is left, then the log message is cut and the fields
+///        are left out.
+/// @param stack_line buffer of the caller with LENGTH_LOG_LINE characters
+/// @param timestamp timestamp of the log event
+/// @param level current log level
+/// @param message the formatted log message
+/// @param message_length number of characters of message
+/// @param fields key and value for each field
+/// @param nbr_of_fields number of pairs in fields
+/// @param colorized true for console output: a colorized text line
+/// @param length number of characters of the log line without the null terminator
+/// @return the log line
+static char *_compose_log_event(Logger *logger, char *stack_line, const char *timestamp, LogLevel level, const char *message, size_t message_length, const char *const *fields, size_t nbr_of_fields, bool colorized, size_t *length) {
+	bool json = logger->json_lines && !colorized;
+	size_t capacity = json
+		? LENGTH_JSON_LINE_OVERHEAD + LENGTH_JSON_ESCAPED(message_length) + _fields_capacity(fields, nbr_of_fields)
+		: LENGTH_LOG_LINE_OVERHEAD + message_length + _fields_capacity(fields, nbr_of_fields);
+	char *line = stack_line;
+
+	if (capacity > LENGTH_LOG_LINE) {
+		line = _reserve_thread_buffer(&_long_line_buffer, capacity);
+
+		if (line == NULL) {
+			size_t limit = json ? (LENGTH_LOG_LINE - LENGTH_JSON_LINE_OVERHEAD) / 6 : LENGTH_LOG_MESSAGE - 1;
+
+			line = stack_line;
+			message_length = message_length < limit ? message_length : limit;
+			nbr_of_fields = 0;
+			atomic_fetch_add(&logger->truncated_log_events, 1);
+		}
+	}
+
+	if (json) {
+		*length = _compose_json_line(line, timestamp, level, message, message_length, fields, nbr_of_fields);
+	} else {
+		*length = _compose_log_line(line, timestamp, level, message, message_length, colorized);
+
+		if (nbr_of_fields > 0) {
+			// the fields replace the line break and get a new one
+			*length += _append_text_fields(line + *length - 1, fields, nbr_of_fields) - 1;
+			line[(*length)++] = '\n';
+			line[*length] = '\0';
+		}
+	}
+
+	return line;
+}
+
+/// @brief Copy the fields of a log event into the rest of a queue slot behind the log message: key and value,
+///        each with its '\0'. Fields, which don't fit, are left out.
+/// @param destination the rest of the slot behind the '\0' of the log message
+/// @param capacity number of characters of destination
+/// @param fields key and value for each field
+/// @param nbr_of_fields number of pairs in fields
+/// @return number of copied pairs
+static size_t _pack_fields(char *destination, size_t capacity, const char *const *fields, size_t nbr_of_fields) {
+	size_t length = 0;
+
+	for (size_t i = 0; i < nbr_of_fields; i++) {
+		size_t key_length = strlen(fields[i * 2]) + 1;
+		size_t value_length = strlen(fields[i * 2 + 1]) + 1;
+
+		if (length + key_length + value_length > capacity) {
+			return i;
+		}
+
+		memcpy(destination + length, fields[i * 2], key_length);
+		memcpy(destination + length + key_length, fields[i * 2 + 1], value_length);
+		length += key_length + value_length;
+	}
+
+	return nbr_of_fields;
+}
+
+/// @brief Find the fields behind the log message of a queue slot, see: _pack_fields()
+/// @param packed the first character behind the '\0' of the log message
+/// @param fields receives key and value for each field
+/// @param nbr_of_fields number of packed pairs
+static void _unpack_fields(const char *packed, const char **fields, size_t nbr_of_fields) {
+	for (size_t i = 0; i < nbr_of_fields * 2; i++) {
+		fields[i] = packed;
+		packed += strlen(packed) + 1;
+	}
+}
+
+/// @brief Write every collected log line of the batch into the log file by a single write.
+///        Does nothing, if batch mode isn't active or the batch is empty.
+///
+///        NOTE: The caller must hold the file_mutex.
+static void _flush_batch(Logger *logger) {
+	if (logger->batch_buffer == NULL) {
+		return;
+	}
+
+	logger->next_flush_in_ms = _now_in_ms() + logger->flush_interval_in_ms;
+
+	if (logger->batch_length == 0) {
+		return;
+	}
+
+	if (!_open_log_file(logger)) {
+		fprintf(stderr, "%sERROR: unable to write the log file...%s: %s\n", _level_colors[4], COLOR_RESET, strerror(errno));
+	}
+	#ifdef LOG_WITH_IO_URING
+	else if (logger->ring != NULL) {
+		// the log file stays open for io_uring, see: _internal_log_initializer()
+		_submit_ring_batch(logger);
+	}
+	#endif
+	else {
+		fwrite(logger->batch_buffer, 1, logger->batch_length, logger->log_file_pointer);
+
+		if (!logger->keep_file_open) {
+			_close_log_file(logger);
+		}
+	}
+
+	// the batch is emptied anyway, otherwise it would grow without any limit
+	logger->batch_length = 0;
+}
+
+/// @brief Write the remaining batch and release it. Following log lines are written one by one.
+///
+///        NOTE: The caller must hold the file_mutex.
+static void _release_batch(Logger *logger) {
+	_flush_batch(logger);
+
+	#ifdef LOG_WITH_IO_URING
+	if (logger->ring != NULL) {
+		// the batches belong to the io_uring instance
+		_wait_for_ring(logger->ring);
+		_destroy_ring(logger->ring);
+		logger->ring = NULL;
+		logger->batch_buffer = NULL;
+	}
+	#endif
+
+	free(logger->batch_buffer);
+	logger->batch_buffer = NULL;
+	logger->batch_capacity = 0;
+	logger->batch_length = 0;
+}
+
+/// @brief Write the batch of each log session with a batch timer, whose flush interval has been passed. Only a single
+///        batch is written without the lock, so a log session may stop its timer in the meantime.
+///        Called by the housekeeping thread with its mutex.
+/// @return time in ms until the next check or -1, if no log session has a batch timer
+static int _flush_due_batches(void) {
+	long long now = _now_in_ms();
+	long long timeout_in_ms = -1;
+
+	for (Logger *logger = _housekeeper.first_batched; logger != NULL; logger = logger->next_batched) {
+		if (now >= logger->next_timer_flush_in_ms) {
+			// _stop_batch_timer() waits, until the batch of the log session isn't written anymore
+			_housekeeper.flushing = logger;
+			_unlock_mutex(&_housekeeper.mutex);
+
+			// a log event may have written the batch in the meantime
+			_lock_mutex(&logger->file_mutex);
+
+			if (_now_in_ms() >= logger->next_flush_in_ms) {
+				_flush_batch(logger);
+			}
+
+			long long next_flush_in_ms = logger->next_flush_in_ms;
+			_unlock_mutex(&logger->file_mutex);
+
+			_lock_mutex(&_housekeeper.mutex);
+			logger->next_timer_flush_in_ms = next_flush_in_ms;
+			_housekeeper.flushing = NULL;
+			_broadcast_condition(&_housekeeper.idle_condition);
+
+			// the log sessions with a batch timer may have been changed
+			return 0;
+		}
+
+		if (timeout_in_ms < 0 || logger->next_timer_flush_in_ms - now < timeout_in_ms) {
+			timeout_in_ms = logger->next_timer_flush_in_ms - now;
+		}
+	}
+
+	return (int)timeout_in_ms;
+}
+
+/// @brief The housekeeping thread. Does every job in its order until the stop has been requested
+///        and no job is left.
+static LOG_THREAD_FUNCTION(_housekeeper_main) {
+	(void)argument;
+	_lock_mutex(&_housekeeper.mutex);
+
+	for (;;) {
+		HousekeepingJob *job = _housekeeper.first_job;
+
+		if (job == NULL) {
+			if (_housekeeper.stop_requested) {
+				break;
+			}
+
+			// -1: nothing to check, the thread waits for the next job
+			int timeout_in_ms = _check_config_files();
+			int flush_timeout_in_ms = timeout_in_ms != 0 ? _flush_due_batches() : 0;
+
+			if (flush_timeout_in_ms >= 0 && (timeout_in_ms < 0 || flush_timeout_in_ms < timeout_in_ms)) {
+				timeout_in_ms = flush_timeout_in_ms;
+			}
+
+			if (timeout_in_ms != 0 && _housekeeper.first_job == NULL && !_housekeeper.stop_requested) {
+				_wait_on_condition(&_housekeeper.job_condition, &_housekeeper.mutex, timeout_in_ms);
+			}
+
+			continue;
+		}
+
+		_housekeeper.first_job = job->next;
+
+		if (_housekeeper.first_job == NULL) {
+			_housekeeper.last_job = NULL;
+		}
+
+		// the file system work is done without the lock, so new jobs can be added in the meantime
+		_housekeeper.busy = true;
+		_unlock_mutex(&_housekeeper.mutex);
+
+		_do_housekeeping_job(job);
+		free(job);
+
+		_lock_mutex(&_housekeeper.mutex);
+		_housekeeper.busy = false;
+
+		if (_housekeeper.first_job == NULL) {
+			_broadcast_condition(&_housekeeper.idle_condition);
+		}
+	}
+
+	_unlock_mutex(&_housekeeper.mutex);
+	return LOG_THREAD_EXIT;
+}
+
+/// @brief Register a log session as user of the housekeeping thread. The first user starts the thread.
+/// @return true, if the housekeeping thread is running, otherwise false
+static bool _use_housekeeper(void) {
+	bool running = true;
+	_lock_mutex(&_housekeeper.mutex);
+
+	if (_housekeeper.nbr_of_users == 0) {
+		_housekeeper.stop_requested = false;
+		running = _start_thread(&_housekeeper.thread, _housekeeper_main, NULL);
+	}
+
+	if (running) {
+		_housekeeper.nbr_of_users++;
+	}
+
+	_unlock_mutex(&_housekeeper.mutex);
+	return running;
+}
+
+/// @brief Wait, until every job of the housekeeping thread has been done.
+static void _wait_for_housekeeper(void) {
+	_lock_mutex(&_housekeeper.mutex);
+
+	while (_housekeeper.first_job != NULL || _housekeeper.busy) {
+		_wait_on_condition(&_housekeeper.idle_condition, &_housekeeper.mutex, 100);
+	}
+
+	_unlock_mutex(&_housekeeper.mutex);
+}
+
+/// @brief Unregister a log session from the housekeeping thread, after every job has been done.
+///        The last user stops the thread.
+static void _leave_housekeeper(void) {
+	_wait_for_housekeeper();
+	_lock_mutex(&_housekeeper.mutex);
+
+	if (--_housekeeper.nbr_of_users > 0) {
+		_unlock_mutex(&_housekeeper.mutex);
+		return;
+	}
+
+	_housekeeper.stop_requested = true;
+	_signal_condition(&_housekeeper.job_condition);
+	_unlock_mutex(&_housekeeper.mutex);
+
+	_join_thread(_housekeeper.thread);
+}
+
+/// @brief Watch the config file of Logging.config_file by the housekeeping thread. The config file is read once at first.
+///        The first log session with Logging.reload_on_sighup installs the handler of SIGHUP.
+/// @return true, if the config file is watched
+static bool _watch_config_file(Logger *logger, const Logging *settings) {
+	_apply_log_config(logger, settings->config_file);
+
+	if (!_use_housekeeper()) {
+		return false;
+	}
+
+	_lock_mutex(&_housekeeper.mutex);
+	snprintf(logger->config_file, sizeof(logger->config_file), "%s", settings->config_file);
+	logger->config_version = _config_file_version(logger->config_file);
+	logger->config_check_interval_in_ms = settings->config_check_interval_in_ms < 1 ? DEFAULT_CONFIG_CHECK_INTERVAL_IN_MS : settings->config_check_interval_in_ms;
+	logger->next_config_check_in_ms = _now_in_ms() + logger->config_check_interval_in_ms;
+	logger->config_reload_requested = false;
+	logger->next_watched = _housekeeper.first_watched;
+	_housekeeper.first_watched = logger;
+
+	#ifndef _WIN32
+	logger->reload_on_sighup = settings->reload_on_sighup;
+
+	if (logger->reload_on_sighup && _housekeeper.nbr_of_sighup_watchers++ == 0) {
+		struct sigaction action = {0};
+		action.sa_handler = _on_sighup;
+		action.sa_flags = SA_RESTART;
+		sigemptyset(&action.sa_mask);
+		sigaction(SIGHUP, &action, &_previous_sighup_action);
+	}
+	#endif
+
+	_signal_condition(&_housekeeper.job_condition);
+	_unlock_mutex(&_housekeeper.mutex);
+	return true;
+}
+
+/// @brief Stop the watch of the config file of a log session, if any. Waits for a reload, which runs right now.
+///        The last log session with Logging.reload_on_sighup restores the previous handler of SIGHUP.
+static void _stop_config_watch(Logger *logger) {
+	if (logger->config_file[0] == '\0') {
+		return;
+	}
+
+	_lock_mutex(&_housekeeper.mutex);
+
+	for (Logger **link = &_housekeeper.first_watched; *link != NULL; link = &(*link)->next_watched) {
+		if (*link == logger) {
+			*link = logger->next_watched;
+			break;
+		}
+	}
+
+	#ifndef _WIN32
+	if (logger->reload_on_sighup && --_housekeeper.nbr_of_sighup_watchers == 0) {
+		sigaction(SIGHUP, &_previous_sighup_action, NULL);
+	}
+	#endif
+
+	logger->reload_on_sighup = false;
+	_unlock_mutex(&_housekeeper.mutex);
+	_leave_housekeeper();
+	logger->config_file[0] = '\0';
+}
+
+/// @brief Let the housekeeping thread write the batch of a log session, when its flush interval has been passed,
+///        so the collected log lines don't wait for the next log event.
+///
+///        NOTE: The caller must hold the file_mutex.
+/// @return true, if the housekeeping thread is running
+static bool _start_batch_timer(Logger *logger) {
+	if (!_use_housekeeper()) {
+		return false;
+	}
+
+	_lock_mutex(&_housekeeper.mutex);
+	logger->batch_timer = true;
+	logger->next_timer_flush_in_ms = logger->next_flush_in_ms;
+	logger->next_batched = _housekeeper.first_batched;
+	_housekeeper.first_batched = logger;
+	_signal_condition(&_housekeeper.job_condition);
+	_unlock_mutex(&_housekeeper.mutex);
+	return true;
+}
+
+/// @brief Stop the batch timer of a log session, if any. Waits for the housekeeping thread, while it writes the batch.
+///
+///        NOTE: The caller must not hold the file_mutex, the housekeeping thread may wait for it.
+static void _stop_batch_timer(Logger *logger) {
+	if (!logger->batch_timer) {
+		return;
+	}
+
+	_lock_mutex(&_housekeeper.mutex);
+
+	for (Logger **link = &_housekeeper.first_batched; *link != NULL; link = &(*link)->next_batched) {
+		if (*link == logger) {
+			*link = logger->next_batched;
+			break;
+		}
+	}
+
+	while (_housekeeper.flushing == logger) {
+		_wait_on_condition(&_housekeeper.idle_condition, &_housekeeper.mutex, 100);
+	}
+
+	_unlock_mutex(&_housekeeper.mutex);
+	_leave_housekeeper();
+	logger->batch_timer = false;
+}
+
+/// @brief Rotate the log files, if the current log file is full or a new day has been begun.
+///
+///        NOTE: The caller must hold the file_mutex.
+static void _rotate_log_files_if_required(Logger *logger) {
+	// depending on which rotation is set, check if a file rotation is required
+	if (logger->log_rotation != NO_ROTATION && _check_for_new_rotation(logger)) {
+		// the collected log lines still belong to the current file, which must be closed before it can be renamed
+		_flush_batch(logger);
+		_release_preallocation(logger);
+		_close_log_file(logger);
+		_rotate_log_files(logger);
+
+		// the new log file starts empty and today
+		logger->bytes_in_current_file = 0;
+		logger->next_day_boundary = _determine_next_day_boundary(time(NULL));
+		logger->binary_file_number++;
+	}
+}
+
+/// @brief Append a complete log line to the log file without any rotation. The log file is opened, if required.
+///        The caller decides, when the log file is closed again.
+///
+///        In batch mode the log line is only collected. The batch is written, if it's full, the flush
+///        interval has been passed or the log line comes with LOG_ERROR or LOG_FATAL.
+///
+///        NOTE: The caller must hold the file_mutex.
+/// @param line the log line from _compose_log_line()
+/// @param length number of characters of line
+/// @param level log level of the log line
+static void _append_log_line_to_file(Logger *logger, const char *line, size_t length, LogLevel level) {
+	if (logger->batch_buffer != NULL) {
+		if (logger->batch_length + length > logger->batch_capacity) {
+			_flush_batch(logger);
+		}
+
+		// a log line, which is longer than the whole batch, is written directly
+		if (length <= logger->batch_capacity) {
+			memcpy(logger->batch_buffer + logger->batch_length, line, length);
+			logger->batch_length += length;
+			logger->bytes_in_current_file += (long long)length;
+
+			if (level >= LOG_ERROR || _now_in_ms() >= logger->next_flush_in_ms) {
+				_flush_batch(logger);
+			}
+
+			return;
+		}
+	}
+
+	// with keep_file_open the file is still open from a previous log event
+	if (!_open_log_file(logger)) {
+		fprintf(stderr, "%sERROR: unable to write the log file...%s: %s\n", _level_colors[4], COLOR_RESET, strerror(errno));
+		return;
+	}
+
+	#ifdef LOG_WITH_IO_URING
+	if (logger->ring != NULL) {
+		logger->bytes_in_current_file += (long long)_write_ring_line_directly(logger->ring, line, length);
+		return;
+	}
+	#endif
+
+	logger->bytes_in_current_file += (long long)fwrite(line, 1, length, logger->log_file_pointer);
+}
+
+/// @brief Write a complete log line into the log file. The rotation is handled before.
+///        See: _append_log_line_to_file()
+///
+///        NOTE: The caller must hold the file_mutex.
+static void _write_log_line_to_file(Logger *logger, const char *line, size_t length, LogLevel level) {
+	_rotate_log_files_if_required(logger);
+	_append_log_line_to_file(logger, line, length, level);
+}
+
+/// @brief Write the summary of the suppressed log messages for Logging.suppress_repeated_messages:
+///        "last message repeated N times" with the level of the repeated log message.
+///
+///        NOTE: The caller must hold the file_mutex.
+/// @param expired_only true, if the summary is only written, if repeat_window_in_ms has been passed
+static void _write_repeat_summary(Logger *logger, bool expired_only) {
+	if (logger->repeat_count == 0 || (expired_only && _now_in_ms() - logger->repeat_since_in_ms < logger->repeat_window_in_ms)) {
+		return;
+	}
+
+	char message[64];
+	char timestamp[LENGTH_PRECISE_TIMESTAMP];
+	char stack_line[LENGTH_LOG_LINE];
+	size_t length;
+
+	int message_length = snprintf(
+		message, sizeof(message), "last message repeated %llu %s", logger->repeat_count, logger->repeat_count == 1 ? "time" : "times"
+	);
+
+	_create_new_timestamp(timestamp, atomic_load_explicit(&logger->timestamp_precision, memory_order_relaxed));
+	char *line = _compose_log_event(
+		logger, stack_line, timestamp, logger->repeat_level, message, (size_t)message_length, NULL, 0, logger->on_console_only, &length
+	);
+
+	if (logger->on_console_only) {
+		fwrite(line, 1, length, stdout);
+	} else {
+		_write_log_line_to_file(logger, line, length, logger->repeat_level);
+	}
+
+	// a following repetition is written again as log message
+	logger->repeat_count = 0;
+	logger->repeat_payload_length = 0;
+}
+
+/// @brief Write the summary of the suppressed log messages and write every following log message.
+///
+///        NOTE: The caller must hold the file_mutex.
+static void _release_repeat_suppression(Logger *logger) {
+	if (logger->repeat_window_in_ms > 0) {
+		_write_repeat_summary(logger, false);
+	}
+
+	logger->repeat_window_in_ms = 0;
+	logger->repeat_payload_length = 0;
+	logger->repeat_count = 0;
+}
+
+/// @brief Check, if a log message is the same as the previous one of the log session for Logging.suppress_repeated_messages.
+///        A repeated log message is only counted. Otherwise the summary of the previous log message is written and the
+///        log message becomes the one to compare with. The same happens for a repetition after repeat_window_in_ms.
+///
+///        NOTE: The caller must hold the file_mutex.
+/// @param level current log level
+/// @param message the formatted log message
+/// @param message_length number of characters of message
+/// @param fields key and value for each field
+/// @param nbr_of_fields number of pairs in fields
+/// @return true, if the log message is repeated and mustn't be written
+static bool _is_repeated_message(Logger *logger, LogLevel level, const char *message, size_t message_length, const char *const *fields, size_t nbr_of_fields) {
+	bool repeated = logger->repeat_payload_length > 0 && level == logger->repeat_level &&
+		message_length == logger->repeat_message_length && nbr_of_fields == logger->repeat_nbr_of_fields &&
+		memcmp(message, logger->repeat_payload, message_length) == 0;
+
+	// the fields behind the log message, see: _pack_fields()
+	const char *packed = logger->repeat_payload + message_length + 1;
+
+	for (size_t i = 0; repeated && i < nbr_of_fields * 2; i++) {
+		repeated = strcmp(fields[i], packed) == 0;
+		packed += strlen(packed) + 1;
+	}
+
+	if (repeated && _now_in_ms() - logger->repeat_since_in_ms < logger->repeat_window_in_ms) {
+		logger->repeat_count++;
+		return true;
+	}
+
+	_write_repeat_summary(logger, false);
+
+	// a log message, which doesn't fit, is never suppressed
+	logger->repeat_since_in_ms = _now_in_ms();
+	logger->repeat_payload_length = 0;
+
+	if (message_length < sizeof(logger->repeat_payload)) {
+		memcpy(logger->repeat_payload, message, message_length);
+		logger->repeat_payload[message_length] = '\0';
+
+		size_t rest = sizeof(logger->repeat_payload) - message_length - 1;
+
+		if (_pack_fields(logger->repeat_payload + message_length + 1, rest, fields, nbr_of_fields) == nbr_of_fields) {
+			logger->repeat_level = level;
+			logger->repeat_message_length = message_length;
+			logger->repeat_nbr_of_fields = nbr_of_fields;
+			logger->repeat_payload_length = message_length + 1;
+		}
+	}
+
+	return false;
+}
+
+/// @brief Parse a single conversion of a format string like printf() does.
+/// @param start the '%' character of the conversion
+/// @return the conversion; BINARY_ARGUMENT_UNSUPPORTED for "%n", wide characters and anything unknown
+static BinaryConversion _parse_conversion(const char *start) {
+	BinaryConversion conversion = {.kind = BINARY_ARGUMENT_UNSUPPORTED, .precision = -1};
+	const char *c = start + 1;
+
+	// flags and width
+	while (*c != '\0' && strchr("-+ #0", *c) != NULL) {
+		c++;
+	}
+
+	if (*c == '*') {
+		conversion.width_argument = true;
+		c++;
+	}
+
+	while (*c >= '0' && *c <= '9') {
+		c++;
+	}
+
+	// precision
+	if (*c == '.') {
+		c++;
+
+		if (*c == '*') {
+			conversion.precision_argument = true;
+			c++;
+		} else {
+			conversion.precision = 0;
+
+			while (*c >= '0' && *c <= '9') {
+				conversion.precision = conversion.precision * 10 + (*c - '0');
+				c++;
+			}
+		}
+	}
+
+	// length modifier
+	if ((c[0] == 'h' || c[0] == 'l') && c[1] == c[0]) {
+		conversion.modifier = c[0] == 'h' ? 'H' : 'q';
+		c += 2;
+	} else if (*c != '\0' && strchr("hljztL", *c) != NULL) {
+		conversion.modifier = *c;
+		c++;
+	}
+
+	switch (*c) {
+		case '%':
+			conversion.kind = BINARY_ARGUMENT_NONE;
+			break;
+		case 'd':
+		case 'i':
+			conversion.kind = BINARY_ARGUMENT_SIGNED;
+			break;
+		case 'u':
+		case 'o':
+		case 'x':
+		case 'X':
+			conversion.kind = BINARY_ARGUMENT_UNSIGNED;
+			break;
+		case 'c':
+			conversion.kind = conversion.modifier == 'l' ? BINARY_ARGUMENT_UNSUPPORTED : BINARY_ARGUMENT_SIGNED;
+			break;
+		case 'f':
+		case 'F':
+		case 'e':
+		case 'E':
+		case 'g':
+		case 'G':
+		case 'a':
+		case 'A':
+			conversion.kind = conversion.modifier == 'L' ? BINARY_ARGUMENT_LONG_DOUBLE : BINARY_ARGUMENT_DOUBLE;
+			break;
+		case 's':
+			conversion.kind = conversion.modifier == 'l' ? BINARY_ARGUMENT_UNSUPPORTED : BINARY_ARGUMENT_STRING;
+			break;
+		case 'p':
+			conversion.kind = BINARY_ARGUMENT_POINTER;
+			break;
+		default:
+			break;
+	}
+
+	if (*c != '\0') {
+		c++;
+	}
+
+	conversion.length = (size_t)(c - start);
+	return conversion;
+}
+
+/// @brief Find the number of a format string. An unknown format string is added with the next free number.
+///        Many threads are able to find a known format string at the same time without any lock.
+/// @param format the format string of the caller
+/// @param locked true, if the caller holds the file_mutex already
+/// @return the number of the format string or -1, if the table is full
+static int _find_binary_format(Logger *logger, const char *format, bool locked) {
+	size_t mask = LOG_BINARY_FORMATS - 1;
+	size_t start = (size_t)(((uintptr_t)format >> 3) * 0x9E3779B1u) & mask;
+
+	for (size_t probe = 0; probe < LOG_BINARY_FORMATS; probe++) {
+		size_t index = (start + probe) & mask;
+		BinaryFormat *entry = &logger->binary_formats[index];
+		const char *known = atomic_load_explicit(&entry->format, memory_order_acquire);
+
+		if (known == NULL) {
+			if (!locked) {
+				// another thread may add the same format string right now, so search again with the lock
+				_lock_mutex(&logger->file_mutex);
+				int result = _find_binary_format(logger, format, true);
+				_unlock_mutex(&logger->file_mutex);
+				return result;
+			}
+
+			size_t length = strlen(format);
+			entry->text = malloc(length + 1);
+
+			if (entry->text == NULL) {
+				return -1;
+			}
+
+			memcpy(entry->text, format, length + 1);
+			entry->written_in_file = 0;
+			atomic_store_explicit(&entry->format, format, memory_order_release);
+			return (int)index;
+		}
+
+		// the same address with another content is a reused buffer, which gets its own number
+		if (known == format && strcmp(entry->text, format) == 0) {
+			return (int)index;
+		}
+	}
+
+	return -1;
+}
+
+/// @brief Copy the raw arguments of a log event behind each other, as they are described by the format string.
+///        A string is copied with its length in front of it.
+/// @param payload destination of the arguments
+/// @param capacity size of payload
+/// @param args the arguments for format; consumed by this function
+/// @return number of bytes or -1, if a conversion isn't supported or the arguments don't fit into payload
+static long _encode_binary_arguments(char *payload, size_t capacity, const char *format, va_list *args) {
+	size_t length = 0;
+
+	#define STORE_ARGUMENT(source, size) do { \
+			if (length + (size) > capacity) { return -1; } \
+			memcpy(payload + length, (source), (size)); \
+			length += (size); \
+		} while (0)
+
+	for (const char *c = strchr(format, '%'); c != NULL; c = strchr(c, '%')) {
+		BinaryConversion conversion = _parse_conversion(c);
+		int precision = conversion.precision;
+		c += conversion.length;
+
+		if (conversion.kind == BINARY_ARGUMENT_NONE) {
+			continue;
+		}
+
+		if (conversion.kind == BINARY_ARGUMENT_UNSUPPORTED) {
+			return -1;
+		}
+
+		if (conversion.width_argument) {
+			int width = va_arg(*args, int);
+			STORE_ARGUMENT(&width, sizeof(width));
+		}
+
+		if (conversion.precision_argument) {
+			precision = va_arg(*args, int);
+			STORE_ARGUMENT(&precision, sizeof(precision));
+		}
+
+		switch (conversion.kind) {
+			case BINARY_ARGUMENT_SIGNED: {
+				long long value;
+
+				switch (conversion.modifier) {
+					case 'l': value = va_arg(*args, long); break;
+					case 'q': value = va_arg(*args, long long); break;
+					case 'j': value = (long long)va_arg(*args, intmax_t); break;
+					case 'z': value = (long long)va_arg(*args, size_t); break;
+					case 't': value = (long long)va_arg(*args, ptrdiff_t); break;
+					default: value = va_arg(*args, int); break;
+				}
+
+				STORE_ARGUMENT(&value, sizeof(value));
+				break;
+			}
+			case BINARY_ARGUMENT_UNSIGNED: {
+				unsigned long long value;
+
+				switch (conversion.modifier) {
+					case 'l': value = va_arg(*args, unsigned long); break;
+					case 'q': value = va_arg(*args, unsigned long long); break;
+					case 'j': value = (unsigned long long)va_arg(*args, uintmax_t); break;
+					case 'z': value = (unsigned long long)va_arg(*args, size_t); break;
+					case 't': value = (unsigned long long)va_arg(*args, ptrdiff_t); break;
+					default: value = va_arg(*args, unsigned int); break;
+				}
+
+				STORE_ARGUMENT(&value, sizeof(value));
+				break;
+			}
+			case BINARY_ARGUMENT_DOUBLE: {
+				double value = va_arg(*args, double);
+				STORE_ARGUMENT(&value, sizeof(value));
+				break;
+			}
+			case BINARY_ARGUMENT_LONG_DOUBLE: {
+				long double value = va_arg(*args, long double);
+				STORE_ARGUMENT(&value, sizeof(value));
+				break;
+			}
+			case BINARY_ARGUMENT_POINTER: {
+				unsigned long long value = (unsigned long long)(uintptr_t)va_arg(*args, void *);
+				STORE_ARGUMENT(&value, sizeof(value));
+				break;
+			}
+			default: {
+				// with a precision only this part of the string is read, it may not be terminated
+				const char *text = va_arg(*args, const char *);
+				uint32_t text_length = UINT32_MAX;
+
+				if (text != NULL) {
+					size_t real_length = 0;
+
+					while ((precision < 0 || real_length < (size_t)precision) && text[real_length] != '\0') {
+						real_length++;
+					}
+
+					text_length = (uint32_t)real_length;
+				}
+
+				STORE_ARGUMENT(&text_length, sizeof(text_length));
+
+				if (text != NULL) {
+					STORE_ARGUMENT(text, text_length);
+				}
+
+				break;
+			}
+		}
+	}
+
+	#undef STORE_ARGUMENT
+
+	return (long)length;
+}
+
+/// @brief Put a log event into a record for a binary log file. The format string is only recorded by its number
+///        and the arguments by their raw bytes. If that isn't possible, then the log message is formatted as usual
+///        (BINARY_RECORD_TEXT) and cut at the capacity of the record.
+/// @param record destination with at least sizeof(BinaryRecordHead) + 1 bytes
+/// @param capacity size of record
+/// @param args the arguments for format; not consumed by this function
+/// @param locked true, if the caller holds the file_mutex already
+/// @return the length of the record
+static size_t _encode_binary_record(Logger *logger, char *record, size_t capacity, LogLevel level, const char *format, va_list args, bool locked) {
+	BinaryRecordHead head = {.type = BINARY_RECORD_EVENT, .level = (uint8_t)level};
+	LogTimestampPrecision precision = atomic_load_explicit(&logger->timestamp_precision, memory_order_relaxed);
+	struct timespec now;
+
+	_read_clock(&now, precision != TIMESTAMP_SECONDS);
+	head.precision = (uint8_t)precision;
+	head.seconds = (int64_t)now.tv_sec;
+	head.nanoseconds = (int32_t)now.tv_nsec;
+
+	char *payload = record + sizeof(head);
+	size_t payload_capacity = capacity - sizeof(head);
+	int format_id = _find_binary_format(logger, format, locked);
+	long length = -1;
+
+	if (format_id >= 0) {
+		va_list args_2;
+		va_copy(args_2, args);
+		length = _encode_binary_arguments(payload, payload_capacity, format, &args_2);
+		va_end(args_2);
+	}
+
+	if (length < 0) {
+		va_list args_2;
+		va_copy(args_2, args);
+		length = vsnprintf(payload, payload_capacity, format, args_2);
+		va_end(args_2);
+
+		if (length < 0) {
+			length = 0;
+		} else if ((size_t)length >= payload_capacity) {
+			length = (long)payload_capacity - 1;
+			atomic_fetch_add(&logger->truncated_log_events, 1);
+		}
+
+		head.type = BINARY_RECORD_TEXT;
+		format_id = 0;
+	}
+
+	head.format_id = (uint32_t)format_id;
+	head.length = (uint32_t)length;
+	memcpy(record, &head, sizeof(head));
+	return sizeof(head) + (size_t)length;
+}
+
+/// @brief Write a record from _encode_binary_record() into the log file. If its format string isn't part
+///        of the current log file yet, then the format string is written before.
+///
+///        NOTE: The caller must hold the file_mutex.
+static void _write_binary_record(Logger *logger, const char *record, size_t length, LogLevel level) {
+	BinaryRecordHead head;
+	memcpy(&head, record, sizeof(head));
+
+	// the format string and its first log event are always written into the same log file
+	_rotate_log_files_if_required(logger);
+
+	if (head.type == BINARY_RECORD_EVENT) {
+		BinaryFormat *entry = &logger->binary_formats[head.format_id];
+
+		if (entry->written_in_file != logger->binary_file_number) {
+			size_t text_length = strlen(entry->text);
+			BinaryRecordHead format_head = {.type = BINARY_RECORD_FORMAT, .format_id = head.format_id, .length = (uint32_t)text_length};
+
+			_append_log_line_to_file(logger, (const char *)&format_head, sizeof(format_head), LOG_TRACE);
+			_append_log_line_to_file(logger, entry->text, text_length, LOG_TRACE);
+			entry->written_in_file = logger->binary_file_number;
+		}
+	}
+
+	_append_log_line_to_file(logger, record, length, level);
+}
+
+/// @brief Release every known format string of a binary log session.
+///
+///        NOTE: The caller must hold the file_mutex and no thread may log into the log session.
+static void _release_binary_formats(Logger *logger) {
+	if (logger->binary_formats == NULL) {
+		return;
+	}
+
+	for (size_t i = 0; i < LOG_BINARY_FORMATS; i++) {
+		free(logger->binary_formats[i].text);
+	}
+
+	free(logger->binary_formats);
+	logger->binary_formats = NULL;
+}
+
+/// @brief Format a log message from the raw arguments of a BINARY_RECORD_EVENT, like printf() would have done.
+///        Each conversion of the format string is formatted on its own by snprintf().
+/// @param message growable destination for the log message
+/// @param text_buffer growable buffer for a single string argument
+/// @param message_length number of characters of the log message
+/// @return true, if the arguments fit to the format string, otherwise false
+static bool _decode_binary_arguments(const char *format, const char *payload, size_t payload_length, ThreadBuffer *message, ThreadBuffer *text_buffer, size_t *message_length) {
+	size_t length = 0;
+	size_t position = 0;
+	const char *c = format;
+
+	#define READ_ARGUMENT(destination, size) do { \
+			if (position + (size) > payload_length) { return false; } \
+			memcpy((destination), payload + position, (size)); \
+			position += (size); \
+		} while (0)
+
+	#define APPEND_TEXT(text, text_length) do { \
+			if (_reserve_thread_buffer(message, length + (text_length) + 1) == NULL) { return false; } \
+			memcpy(message->data + length, (text), (text_length)); \
+			length += (text_length); \
+		} while (0)
+
+	// the width and the precision from an argument come in front of the value
+	#define APPEND_CONVERSION(value) do { \
+			int printed = 0; \
+			for (int attempt = 0; attempt < 2; attempt++) { \
+				if (_reserve_thread_buffer(message, length + 1) == NULL) { return false; } \
+				size_t space = message->capacity - length; \
+				char *destination = message->data + length; \
+				if (conversion.width_argument && conversion.precision_argument) { printed = snprintf(destination, space, specification, width, precision, (value)); } \
+				else if (conversion.width_argument) { printed = snprintf(destination, space, specification, width, (value)); } \
+				else if (conversion.precision_argument) { printed = snprintf(destination, space, specification, precision, (value)); } \
+				else { printed = snprintf(destination, space, specification, (value)); } \
+				if (printed < 0) { return false; } \
+				if ((size_t)printed < space) { break; } \
+				if (_reserve_thread_buffer(message, length + (size_t)printed + 1) == NULL) { return false; } \
+			} \
+			length += (size_t)printed; \
+		} while (0)
+
+	for (const char *next = strchr(c, '%'); next != NULL; next = strchr(c, '%')) {
+		APPEND_TEXT(c, (size_t)(next - c));
+
+		BinaryConversion conversion = _parse_conversion(next);
+		char specification[32];
+		int width = 0;
+		int precision = conversion.precision;
+		c = next + conversion.length;
+
+		if (conversion.kind == BINARY_ARGUMENT_NONE) {
+			APPEND_TEXT("%", 1);
+			continue;
+		}
+
+		if (conversion.kind == BINARY_ARGUMENT_UNSUPPORTED || conversion.length >= sizeof(specification)) {
+			return false;
+		}
+
+		memcpy(specification, next, conversion.length);
+		specification[conversion.length] = '\0';
+
+		if (conversion.width_argument) {
+			READ_ARGUMENT(&width, sizeof(width));
+		}
+
+		if (conversion.precision_argument) {
+			READ_ARGUMENT(&precision, sizeof(precision));
+		}
+
+		switch (conversion.kind) {
+			case BINARY_ARGUMENT_SIGNED: {
+				long long value;
+				READ_ARGUMENT(&value, sizeof(value));
+
+				switch (conversion.modifier) {
+					case 'l': APPEND_CONVERSION((long)value); break;
+					case 'q': APPEND_CONVERSION(value); break;
+					case 'j': APPEND_CONVERSION((intmax_t)value); break;
+					case 'z':
+					case 't': APPEND_CONVERSION((ptrdiff_t)value); break;
+					default: APPEND_CONVERSION((int)value); break;
+				}
+
+				break;
+			}
+			case BINARY_ARGUMENT_UNSIGNED: {
+				unsigned long long value;
+				READ_ARGUMENT(&value, sizeof(value));
+
+				switch (conversion.modifier) {
+					case 'l': APPEND_CONVERSION((unsigned long)value); break;
+					case 'q': APPEND_CONVERSION(value); break;
+					case 'j': APPEND_CONVERSION((uintmax_t)value); break;
+					case 'z':
+					case 't': APPEND_CONVERSION((size_t)value); break;
+					default: APPEND_CONVERSION((unsigned int)value); break;
+				}
+
+				break;
+			}
+			case BINARY_ARGUMENT_DOUBLE: {
+				double value;
+				READ_ARGUMENT(&value, sizeof(value));
+				APPEND_CONVERSION(value);
+				break;
+			}
+			case BINARY_ARGUMENT_LONG_DOUBLE: {
+				long double value;
+				READ_ARGUMENT(&value, sizeof(value));
+				APPEND_CONVERSION(value);
+				break;
+			}
+			case BINARY_ARGUMENT_POINTER: {
+				unsigned long long value;
+				READ_ARGUMENT(&value, sizeof(value));
+				APPEND_CONVERSION((void *)(uintptr_t)value);
+				break;
+			}
+			default: {
+				uint32_t text_length;
+				READ_ARGUMENT(&text_length, sizeof(text_length));
+
+				if (text_length == UINT32_MAX) {
+					APPEND_CONVERSION("(null)");
+					break;
+				}
+
+				// the recorded part of the string isn't terminated
+				char *text = _reserve_thread_buffer(text_buffer, (size_t)text_length + 1);
+
+				if (text == NULL) {
+					return false;
+				}
+
+				READ_ARGUMENT(text, text_length);
+				text[text_length] = '\0';
+				APPEND_CONVERSION(text);
+				break;
+			}
+		}
+	}
+
+	APPEND_TEXT(c, strlen(c));
+
+	#undef APPEND_CONVERSION
+	#undef APPEND_TEXT
+	#undef READ_ARGUMENT
+
+	*message_length = length;
+	return position == payload_length;
+}
+
+/// @brief Map the log file to use into the segment. The file is extended to size_for_file_size, the log lines
+///        of an existing log file are kept and appended.
+///
+///        NOTE: The caller must hold the file_mutex.
+/// @return true, if the segment is mapped, otherwise false
+static bool _map_segment(Logger *logger, MappedSegment *segment) {
+	size_t size = (size_t)logger->size_for_file_size;
+	size_t existing = 0;
+
+	#ifdef _WIN32
+	segment->file = CreateFileA(logger->log_file_to_use, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_DELETE, NULL, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+
+	if (segment->file == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+
+	LARGE_INTEGER file_size;
+	existing = GetFileSizeEx(segment->file, &file_size) ? (size_t)file_size.QuadPart : 0;
+	LARGE_INTEGER mapping_size = {.QuadPart = (LONGLONG)(existing > size ? existing : size)};
+
+	segment->mapping = CreateFileMappingA(segment->file, NULL, PAGE_READWRITE, (DWORD)(mapping_size.QuadPart >> 32), (DWORD)mapping_size.QuadPart, NULL);
+	segment->data = segment->mapping == NULL ? NULL : MapViewOfFile(segment->mapping, FILE_MAP_WRITE, 0, 0, 0);
+
+	if (segment->data == NULL) {
+		if (segment->mapping != NULL) {
+			CloseHandle(segment->mapping);
+		}
+
+		CloseHandle(segment->file);
+		return false;
+	}
+	#else
+	segment->file_descriptor = open(logger->log_file_to_use, O_RDWR | O_CREAT, 0644);
+
+	if (segment->file_descriptor < 0) {
+		return false;
+	}
+
+	struct stat st;
+	existing = fstat(segment->file_descriptor, &st) == 0 ? (size_t)st.st_size : 0;
+
+	if (existing < size && ftruncate(segment->file_descriptor, (off_t)size) != 0) {
+		close(segment->file_descriptor);
+		return false;
+	}
+
+	void *data = mmap(NULL, existing > size ? existing : size, PROT_READ | PROT_WRITE, MAP_SHARED, segment->file_descriptor, 0);
+
+	if (data == MAP_FAILED) {
+		// give the log file its real length back
+		int restored = ftruncate(segment->file_descriptor, (off_t)existing);
+		(void)restored;
+
+		close(segment->file_descriptor);
+		return false;
+	}
+
+	segment->data = data;
+	#endif
+
+	segment->size = existing > size ? existing : size;
+	atomic_store(&segment->offset, existing);
+	atomic_store(&segment->committed, existing);
+	return true;
+}
+
+/// @brief Unmap a segment and cut its log file to the real length. Waits, until no thread copies into it.
+///
+///        NOTE: The caller must hold the file_mutex.
+static void _unmap_segment(MappedSegment *segment) {
+	while (atomic_load(&segment->writers) != 0) {
+		_yield_thread();
+	}
+
+	size_t length = atomic_load(&segment->committed);
+
+	#ifdef _WIN32
+	UnmapViewOfFile(segment->data);
+	CloseHandle(segment->mapping);
+
+	LARGE_INTEGER end = {.QuadPart = (LONGLONG)length};
+	SetFilePointerEx(segment->file, end, NULL, FILE_BEGIN);
+	SetEndOfFile(segment->file);
+	CloseHandle(segment->file);
+	#else
+	munmap(segment->data, segment->size);
+
+	if (ftruncate(segment->file_descriptor, (off_t)length) != 0) {
+		fprintf(stderr, "%sERROR: unable to cut the mapped log file to its length: %s%s\n", _level_colors[4], strerror(errno), COLOR_RESET);
+	}
+
+	close(segment->file_descriptor);
+	#endif
+
+	segment->data = NULL;
+}
+
+/// @brief Map the first segment of a log session. If it fails, then the log lines are written as usual.
+///
+///        NOTE: The caller must hold the file_mutex.
+static bool _start_memory_mapping(Logger *logger) {
+	if (!_map_segment(logger, &logger->mapped_segments[0])) {
+		atomic_store(&logger->current_mapped_segment, -1);
+		return false;
+	}
+
+	atomic_store(&logger->current_mapped_segment, 0);
+	return true;
+}
+
+/// @brief Unmap the segment in use. Following log lines are written as usual.
+///
+///        NOTE: The caller must hold the file_mutex.
+static void _stop_memory_mapping(Logger *logger) {
+	int current = atomic_exchange(&logger->current_mapped_segment, -1);
+
+	if (current >= 0) {
+		_unmap_segment(&logger->mapped_segments[current]);
+	}
+}
+
+/// @brief Rotate a full segment: unmap it, rotate the log files and map the new log file into the other segment.
+///        Only the first thread, which finds the segment full, does the rotation.
+/// @param full index of the full segment
+static void _rotate_mapped_segment(Logger *logger, int full) {
+	_lock_mutex(&logger->file_mutex);
+
+	if (atomic_load(&logger->current_mapped_segment) == full) {
+		MappedSegment *next = &logger->mapped_segments[1 - full];
+
+		_unmap_segment(&logger->mapped_segments[full]);
+		_rotate_log_files(logger);
+
+		// a thread, which still holds the full segment, tries again with the new one
+		atomic_store(&logger->current_mapped_segment, _map_segment(logger, next) ? 1 - full : -1);
+	}
+
+	_unlock_mutex(&logger->file_mutex);
+}
+
+/// @brief Copy a complete log line into the mapped log file without any lock.
+/// @param line the log line from _compose_log_line()
+/// @param length number of characters of line
+/// @return true, if the log line has been written, false, if no segment is mapped
+static bool _write_log_line_to_mapping(Logger *logger, const char *line, size_t length) {
+	for (;;) {
+		int current = atomic_load(&logger->current_mapped_segment);
+
+		if (current < 0) {
+			return false;
+		}
+
+		MappedSegment *segment = &logger->mapped_segments[current];
+		atomic_fetch_add(&segment->writers, 1);
+
+		// the segment may have been rotated in the meantime
+		if (atomic_load(&logger->current_mapped_segment) != current) {
+			atomic_fetch_sub(&segment->writers, 1);
+			continue;
+		}
+
+		// a log line, which doesn't fit into a whole segment, is cut
+		if (length > (size_t)logger->size_for_file_size) {
+			length = (size_t)logger->size_for_file_size;
+			atomic_fetch_add(&logger->truncated_log_events, 1);
+		}
+
+		size_t position = atomic_fetch_add(&segment->offset, length);
+
+		if (position + length <= segment->size) {
+			memcpy(segment->data + position, line, length);
+			atomic_fetch_add(&segment->committed, length);
+			atomic_fetch_sub(&segment->writers, 1);
+			return true;
+		}
+
+		atomic_fetch_sub(&segment->writers, 1);
+		_rotate_mapped_segment(logger, current);
+	}
+}
+
+/// @brief Reserve the next free slot of the queue for a producer. Many producers are able
+///        to call this function at the same time.
+/// @param position the reserved position; required by _async_publish_slot()
+/// @return the reserved slot or NULL, if the queue is full
+static AsyncLogSlot *_async_reserve_slot(Logger *logger, size_t *position) {
+	size_t current = atomic_load_explicit(&logger->async_enqueue_position, memory_order_relaxed);
+
+	for (;;) {
+		AsyncLogSlot *slot = &logger->async_slots[current & logger->async_mask];
+		size_t sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+		intptr_t difference = (intptr_t)sequence - (intptr_t)current;
+
+		if (difference == 0) {
+			// the slot is free: try to claim it, otherwise current holds the newer position
+			if (atomic_compare_exchange_weak_explicit(&logger->async_enqueue_position, &current, current + 1, memory_order_relaxed, memory_order_relaxed)) {
+				*position = current;
+				return slot;
+			}
+		} else if (difference < 0) {
+			// the slot still holds a log event from the previous round
+			return NULL;
+		} else {
+			// another producer was faster
+			current = atomic_load_explicit(&logger->async_enqueue_position, memory_order_relaxed);
+		}
+	}
+}
+
+/// @brief Take the oldest log event out of the queue.
+/// @param position the taken position; required by _async_release_slot()
+/// @return the slot with the oldest log event or NULL, if no log event is ready
+static AsyncLogSlot *_async_take_slot(Logger *logger, size_t *position) {
+	size_t current = atomic_load_explicit(&logger->async_dequeue_position, memory_order_relaxed);
+
+	for (;;) {
+		AsyncLogSlot *slot = &logger->async_slots[current & logger->async_mask];
+		size_t sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+		intptr_t difference = (intptr_t)sequence - (intptr_t)(current + 1);
+
+		if (difference == 0) {
+			if (atomic_compare_exchange_weak_explicit(&logger->async_dequeue_position, &current, current + 1, memory_order_relaxed, memory_order_relaxed)) {
+				*position = current;
+				return slot;
+			}
+		} else if (difference < 0) {
+			// empty or the producer is still formatting
+			return NULL;
+		} else {
+			current = atomic_load_explicit(&logger->async_dequeue_position, memory_order_relaxed);
+		}
+	}
+}
+
+/// @brief Hand over a filled slot to the writer thread. Wakes up the writer thread, if it's waiting.
+static void _async_publish_slot(Logger *logger, AsyncLogSlot *slot, size_t position) {
+	atomic_store_explicit(&slot->sequence, position + 1, memory_order_release);
+
+	// the writer thread checks the queue again after announcing its sleep, so one of both sides sees the other one
+	atomic_thread_fence(memory_order_seq_cst);
+
+	if (atomic_load(&logger->async_writer_sleeping)) {
+		_lock_mutex(&logger->async_mutex);
+		_signal_condition(&logger->async_condition);
+		_unlock_mutex(&logger->async_mutex);
+	}
+}
+
+/// @brief Mark a taken slot as free for the next round of producers.
+static void _async_release_slot(Logger *logger, AsyncLogSlot *slot, size_t position) {
+	atomic_store_explicit(&slot->sequence, position + logger->async_mask + 1, memory_order_release);
+}
+
+/// @brief Check, if the next slot for the writer thread holds a log event.
+static bool _async_queue_is_empty(Logger *logger) {
+	size_t current = atomic_load(&logger->async_dequeue_position);
+	return atomic_load(&logger->async_slots[current & logger->async_mask].sequence) != current + 1;
+}
+
+/// @brief Reserve a slot and follow the overflow policy, if the queue is full.
+/// @param position the reserved position; required by _async_publish_slot()
+/// @return the reserved slot or NULL, if the log event has been dropped
+static AsyncLogSlot *_async_reserve_slot_by_policy(Logger *logger, size_t *position) {
+	for (;;) {
+		AsyncLogSlot *slot = _async_reserve_slot(logger, position);
+
+		if (slot != NULL) {
+			return slot;
+		}
+
+		if (logger->overflow_policy == OVERFLOW_DROP_NEWEST) {
+			atomic_fetch_add(&logger->dropped_log_events, 1);
+			return NULL;
+		}
+
+		if (logger->overflow_policy == OVERFLOW_DROP_OLDEST) {
+			size_t oldest_position;
+			AsyncLogSlot *oldest = _async_take_slot(logger, &oldest_position);
+
+			if (oldest != NULL) {
+				_async_release_slot(logger, oldest, oldest_position);
+				atomic_fetch_add(&logger->dropped_log_events, 1);
+				continue;
+			}
+		}
+
+		// OVERFLOW_BLOCK: wait, until the writer thread has made space
+		_yield_thread();
+	}
+}
+
+/// @brief Register the calling thread as producer for the queue.
+/// @return true, if async mode is active and the queue can be used until _leave_async_producer(),
+///         otherwise false
+static bool _enter_async_producer(Logger *logger) {
+	if (!atomic_load_explicit(&logger->async_mode, memory_order_relaxed)) {
+		return false;
+	}
+
+	atomic_fetch_add(&logger->async_producers, 1);
+
+	// async mode may have been stopped in the meantime
+	if (!atomic_load(&logger->async_mode)) {
+		atomic_fetch_sub(&logger->async_producers, 1);
+		return false;
+	}
+
+	return true;
+}
+
+static void _leave_async_producer(Logger *logger) {
+	atomic_fetch_sub(&logger->async_producers, 1);
+}
+
+/// @brief The background writer thread. Writes every queued log event into the log file until
+///        the stop has been requested and the queue is empty.
+static LOG_THREAD_FUNCTION(_async_writer_main) {
+	Logger *logger = (Logger *)argument;
+
+	for (;;) {
+		size_t position;
+		AsyncLogSlot *slot = _async_take_slot(logger, &position);
+
+		if (slot != NULL && slot->binary_length > 0) {
+			_lock_mutex(&logger->file_mutex);
+			_write_binary_record(logger, slot->message, slot->binary_length, slot->level);
+			_unlock_mutex(&logger->file_mutex);
+
+			_async_release_slot(logger, slot, position);
+			continue;
+		}
+
+		if (slot != NULL) {
+			char stack_line[LENGTH_LOG_LINE];
+			const char *fields[MAX_LOG_FIELDS * 2];
+			size_t message_length = strlen(slot->message);
+			size_t length;
+
+			_unpack_fields(slot->message + message_length + 1, fields, slot->nbr_of_fields);
+
+			if (logger->repeat_window_in_ms > 0) {
+				// a repeated log message is only counted and isn't composed at all
+				_lock_mutex(&logger->file_mutex);
+
+				if (!_is_repeated_message(logger, slot->level, slot->message, message_length, fields, slot->nbr_of_fields)) {
+					char *line = _compose_log_event(
+						logger, stack_line, slot->timestamp, slot->level, slot->message, message_length, fields, slot->nbr_of_fields, false, &length
+					);
+					_write_log_line_to_file(logger, line, length, slot->level);
+				}
+
+				_unlock_mutex(&logger->file_mutex);
+				_async_release_slot(logger, slot, position);
+				continue;
+			}
+
+			char *line = _compose_log_event(
+				logger, stack_line, slot->timestamp, slot->level, slot->message, message_length, fields, slot->nbr_of_fields, false, &length
+			);
+
+			if (!logger->memory_mapped_files || !_write_log_line_to_mapping(logger, line, length)) {
+				_lock_mutex(&logger->file_mutex);
+				_write_log_line_to_file(logger, line, length, slot->level);
+				_unlock_mutex(&logger->file_mutex);
+			}
+
+			_async_release_slot(logger, slot, position);
+			continue;
+		}
+
+		if (atomic_load(&logger->async_stop_requested)) {
+			break;
+		}
+
+		// nothing to do: make the written log events visible, before waiting for new ones
+		_lock_mutex(&logger->file_mutex);
+
+		// a storm of repeated log messages is summarized after its window, even without a further log event
+		if (logger->repeat_window_in_ms > 0) {
+			_write_repeat_summary(logger, true);
+		}
+
+		// a batch is kept until its flush interval has been passed, so waiting doesn't split it up
+		if (logger->batch_buffer != NULL && _now_in_ms() >= logger->next_flush_in_ms) {
+			_flush_batch(logger);
+		}
+
+		if (!logger->keep_file_open) {
+			_close_log_file(logger);
+		} else if (logger->log_file_pointer != NULL) {
+			fflush(logger->log_file_pointer);
+		}
+
+		_unlock_mutex(&logger->file_mutex);
+
+		_lock_mutex(&logger->async_mutex);
+		atomic_store(&logger->async_writer_sleeping, true);
+
+		if (_async_queue_is_empty(logger) && !atomic_load(&logger->async_stop_requested)) {
+			_wait_on_condition(&logger->async_condition, &logger->async_mutex, 10);
+		}
+
+		atomic_store(&logger->async_writer_sleeping, false);
+		_unlock_mutex(&logger->async_mutex);
+	}
+
+	// a long JSON line may have been composed in the buffer of this thread
+	_release_thread_buffers();
+	return LOG_THREAD_EXIT;
+}
+
+/// @brief Create the queue and start the background writer thread for async mode.
+/// @param queue_size the requested number of slots; rounded up to a power of 2
+/// @param policy what to do, if the queue is full
+/// @return true, if async mode is active, otherwise false
+static bool _start_async_writer(Logger *logger, int queue_size, LogOverflowPolicy policy) {
+	size_t capacity = 2;
+
+	while (capacity < (size_t)queue_size) {
+		capacity <<= 1;
+	}
+
+	logger->async_slots = malloc(capacity * sizeof(AsyncLogSlot));
+
+	if (logger->async_slots == NULL) {
+		return false;
+	}
+
+	for (size_t i = 0; i < capacity; i++) {
+		atomic_init(&logger->async_slots[i].sequence, i);
+	}
+
+	logger->async_mask = capacity - 1;
+	logger->overflow_policy = policy;
+	atomic_store(&logger->async_enqueue_position, 0);
+	atomic_store(&logger->async_dequeue_position, 0);
+	atomic_store(&logger->async_writer_sleeping, false);
+	atomic_store(&logger->async_stop_requested, false);
+	_init_mutex_and_condition(&logger->async_mutex, &logger->async_condition);
+
+	if (!_start_thread(&logger->async_writer, _async_writer_main, logger)) {
+		_destroy_mutex_and_condition(&logger->async_mutex, &logger->async_condition);
+		free(logger->async_slots);
+		logger->async_slots = NULL;
+		return false;
+	}
+
+	atomic_store(&logger->async_mode, true);
+	return true;
+}
+
+/// @brief Stop the background writer thread, after every queued log event has been written.
+///        Does nothing, if async mode isn't active.
+static void _stop_async_writer(Logger *logger) {
+	if (!atomic_load(&logger->async_mode)) {
+		return;
+	}
+
+	// following log events are written on the caller's thread, but producers,
+	// which are already inside of the queue, must finish first
+	atomic_store(&logger->async_mode, false);
+
+	while (atomic_load(&logger->async_producers) != 0) {
+		_yield_thread();
+	}
+
+	_lock_mutex(&logger->async_mutex);
+	atomic_store(&logger->async_stop_requested, true);
+	_signal_condition(&logger->async_condition);
+	_unlock_mutex(&logger->async_mutex);
+
+	_join_thread(logger->async_writer);
+	_destroy_mutex_and_condition(&logger->async_mutex, &logger->async_condition);
+
+	free(logger->async_slots);
+	logger->async_slots = NULL;
+}
+
+/// @brief Write a formatted log message with its fields on the caller's thread: into the mapped log file,
+///        to the console or into the log file.
+/// @param level current log level
+/// @param message the formatted log message
+/// @param message_length number of characters of message
+/// @param fields key and value for each field
+/// @param nbr_of_fields number of pairs in fields
+/// @param timestamp timestamp of the log event or NULL for now
+static void _write_log_message(Logger *logger, LogLevel level, const char *message, size_t message_length, const char *const *fields, size_t nbr_of_fields, const char *timestamp) {
+	char timestamp_of_now[LENGTH_PRECISE_TIMESTAMP];
+
+	if (timestamp == NULL) {
+		_create_new_timestamp(timestamp_of_now, atomic_load_explicit(&logger->timestamp_precision, memory_order_relaxed));
+		timestamp = timestamp_of_now;
+	}
+
+	char stack_line[LENGTH_LOG_LINE];
+	size_t length;
+	char *line = NULL;
+
+	if (logger->repeat_window_in_ms == 0) {
+		// the log line is composed before the lock, so only the output itself needs it
+		line = _compose_log_event(logger, stack_line, timestamp, level, message, message_length, fields, nbr_of_fields, logger->on_console_only, &length);
+	}
+
+	if (logger->memory_mapped_files) {
+		// many threads are copying into the mapped log file at the same time
+		if (_write_log_line_to_mapping(logger, line, length)) {
+			return;
+		}
+
+		_lock_mutex(&logger->file_mutex);
+		_write_log_line_to_file(logger, line, length, level);
+		_close_log_file(logger);
+		_unlock_mutex(&logger->file_mutex);
+		return;
+	}
+
+	_lock_mutex(&logger->file_mutex);
+
+	if (line == NULL) {
+		// a repeated log message is only counted and isn't composed at all
+		if (_is_repeated_message(logger, level, message, message_length, fields, nbr_of_fields)) {
+			_unlock_mutex(&logger->file_mutex);
+			return;
+		}
+
+		line = _compose_log_event(logger, stack_line, timestamp, level, message, message_length, fields, nbr_of_fields, logger->on_console_only, &length);
+	}
+
+	if (logger->on_console_only) {
+		// the complete colorized line is written at once, so it can't be mixed with another line
+		fwrite(line, 1, length, stdout);
+	} else {
+		_write_log_line_to_file(logger, line, length, level);
+
+		if (!logger->keep_file_open) {
+			_close_log_file(logger);
+		}
+	}
+
+	_unlock_mutex(&logger->file_mutex);
+}
+
+/// @brief Receive the unique number of the current thread for its ring buffers. The address of a thread local variable
+///        isn't unique, since a new thread gets the memory of a finished one again.
+static unsigned long long _current_recorder_thread(void) {
+	if (_recorder_thread == 0) {
+		_recorder_thread = atomic_fetch_add(&_recorder_threads, 1) + 1;
+	}
+
+	return _recorder_thread;
+}
+
+/// @brief Find the ring buffer of the current thread for Logging.flight_recorder or create it.
+/// @return the ring buffer or NULL, if the log session has no flight recorder or no memory is left
+static FlightRecorder *_find_flight_recorder(Logger *logger) {
+	if (_recorder_logger == logger && _recorder_session == logger->recorder_session) {
+		return _flight_recorder;
+	}
+
+	FlightRecorder *recorder = NULL;
+	unsigned long long thread = _current_recorder_thread();
+	_lock_mutex(&logger->file_mutex);
+
+	if (logger->recorder_capacity > 0) {
+		// a thread, which logs into another log session in between, finds its ring buffer again
+		for (recorder = logger->flight_recorders; recorder != NULL; recorder = recorder->next_recorder) {
+			if (recorder->owner == thread) {
+				break;
+			}
+		}
+
+		if (recorder == NULL && (recorder = calloc(1, sizeof(FlightRecorder) + logger->recorder_capacity)) != NULL) {
+			recorder->data = (char *)(recorder + 1);
+			recorder->capacity = logger->recorder_capacity;
+			recorder->owner = thread;
+			recorder->next_recorder = logger->flight_recorders;
+			logger->flight_recorders = recorder;
+		}
+	}
+
+	if (recorder != NULL) {
+		_flight_recorder = recorder;
+		_recorder_logger = logger;
+		_recorder_session = logger->recorder_session;
+	}
+
+	_unlock_mutex(&logger->file_mutex);
+	return recorder;
+}
+
+/// @brief Receive the start of the kept log event at a position of the ring buffer.
+/// @return position or 0, if the used part of the ring buffer ends at position
+static size_t _find_recorded_event(const FlightRecorder *recorder, size_t position) {
+	uint32_t size;
+
+	if (position + sizeof(size) > recorder->capacity) {
+		return 0;
+	}
+
+	memcpy(&size, recorder->data + position, sizeof(size));
+	return size == 0 ? 0 : position;
+}
+
+/// @brief Remove the oldest kept log event from the ring buffer.
+static void _drop_recorded_event(FlightRecorder *recorder) {
+	RecordedLogEvent head;
+	size_t position = _find_recorded_event(recorder, recorder->oldest);
+
+	memcpy(&head, recorder->data + position, sizeof(head));
+	recorder->oldest = position + head.size;
+
+	if (--recorder->nbr_of_events == 0) {
+		recorder->oldest = 0;
+		recorder->next = 0;
+	}
+}
+
+/// @brief Keep a log event below the log level in the ring buffer of the current thread. The oldest log events
+///        are overwritten, until the log event fits. Nothing is written.
+/// @param level current log level
+/// @param payload the log message with its '\0', followed by the fields, see: _pack_fields()
+/// @param payload_length number of characters of payload; at most LENGTH_LOG_MESSAGE
+/// @param nbr_of_fields number of pairs behind the log message
+static void _record_log_event(Logger *logger, LogLevel level, const char *payload, size_t payload_length, size_t nbr_of_fields) {
+	FlightRecorder *recorder = _find_flight_recorder(logger);
+	size_t size = (sizeof(RecordedLogEvent) + payload_length + 7) & ~(size_t)7;
+
+	if (recorder == NULL || size > recorder->capacity) {
+		return;
+	}
+
+	size_t position;
+
+	for (;;) {
+		bool overwrites = false;
+		position = recorder->next + size > recorder->capacity ? 0 : recorder->next;
+
+		if (recorder->nbr_of_events > 0 && recorder->oldest < recorder->next) {
+			// the kept log events are in [oldest, next), only a log event at the beginning may reach them
+			overwrites = position == 0 && size > recorder->oldest;
+		} else if (recorder->nbr_of_events > 0) {
+			// the kept log events are in [oldest, end) and [0, next)
+			overwrites = position == 0 || position + size > recorder->oldest;
+		}
+
+		if (!overwrites) {
+			break;
+		}
+
+		_drop_recorded_event(recorder);
+	}
+
+	if (position == 0 && recorder->next > 0 && recorder->next + sizeof(uint32_t) <= recorder->capacity) {
+		// the end of the used part
+		memset(recorder->data + recorder->next, 0, sizeof(uint32_t));
+	}
+
+	RecordedLogEvent head = {
+		.size = (uint32_t)size,
+		.payload_length = (uint32_t)payload_length,
+		.nbr_of_fields = (uint32_t)nbr_of_fields,
+		.level = level
+	};
+
+	// only the time is taken, the timestamp is formatted, if the log event is written at all
+	_read_clock(&head.time, atomic_load_explicit(&logger->timestamp_precision, memory_order_relaxed) != TIMESTAMP_SECONDS);
+	memcpy(recorder->data + position, &head, sizeof(head));
+	memcpy(recorder->data + position + sizeof(head), payload, payload_length);
+
+	recorder->next = position + size;
+	recorder->nbr_of_events++;
+}
+
+/// @brief Keep a log event from write_to_log() below the log level, see: _record_log_event()
+/// @param level current log level
+/// @param format the formatted text
+/// @param args the arguments for format
+static void _record_formatted_log_event(Logger *logger, LogLevel level, const char *format, va_list args) {
+	char payload[LENGTH_LOG_MESSAGE];
+	int message_length = vsnprintf(payload, sizeof(payload), format, args);
+
+	if (message_length < 0) {
+		message_length = 0;
+		payload[0] = '\0';
+	} else if (message_length >= (int)sizeof(payload)) {
+		message_length = sizeof(payload) - 1;
+		atomic_fetch_add(&logger->truncated_log_events, 1);
+	}
+
+	_record_log_event(logger, level, payload, (size_t)message_length + 1, 0);
+}
+
+/// @brief Write every kept log event of the current thread in its order before a LOG_ERROR or LOG_FATAL log event.
+///        Each log event gets the timestamp of its time. The ring buffer is empty afterwards.
+static void _replay_flight_recorder(Logger *logger) {
+	if (
+		atomic_load_explicit(&logger->recorder_level, memory_order_relaxed) == LOG_RECORDER_INACTIVE ||
+		_recorder_logger != logger || _recorder_session != logger->recorder_session || _flight_recorder->nbr_of_events == 0
+	) {
+		return;
+	}
+
+	FlightRecorder *recorder = _flight_recorder;
+	LogTimestampPrecision precision = atomic_load_explicit(&logger->timestamp_precision, memory_order_relaxed);
+	bool async = _enter_async_producer(logger);
+	size_t position = recorder->oldest;
+
+	for (size_t i = 0; i < recorder->nbr_of_events; i++) {
+		RecordedLogEvent head;
+		char timestamp[LENGTH_PRECISE_TIMESTAMP];
+
+		position = _find_recorded_event(recorder, position);
+		memcpy(&head, recorder->data + position, sizeof(head));
+		const char *payload = recorder->data + position + sizeof(head);
+		_format_timestamp(timestamp, &head.time, precision);
+
+		if (async) {
+			// the kept log events are queued before the log event, which has caused them to be written
+			size_t slot_position;
+			AsyncLogSlot *slot = _async_reserve_slot_by_policy(logger, &slot_position);
+
+			if (slot != NULL) {
+				memcpy(slot->message, payload, head.payload_length);
+				memcpy(slot->timestamp, timestamp, sizeof(timestamp));
+				slot->nbr_of_fields = head.nbr_of_fields;
+				slot->binary_length = 0;
+				slot->level = head.level;
+				_async_publish_slot(logger, slot, slot_position);
+			}
+		} else {
+			const char *fields[MAX_LOG_FIELDS * 2];
+			size_t message_length = strlen(payload);
+
+			_unpack_fields(payload + message_length + 1, fields, head.nbr_of_fields);
+			_write_log_message(logger, head.level, payload, message_length, fields, head.nbr_of_fields, timestamp);
+		}
+
+		position += head.size;
+	}
+
+	if (async) {
+		_leave_async_producer(logger);
+	}
+
+	recorder->oldest = 0;
+	recorder->next = 0;
+	recorder->nbr_of_events = 0;
+}
+
+/// @brief Release the ring buffer of every thread of a log session with Logging.flight_recorder.
+///
+///        NOTE: The caller must hold the file_mutex and no thread may log into the log session.
+static void _release_flight_recorders(Logger *logger) {
+	atomic_store(&logger->recorder_level, LOG_RECORDER_INACTIVE);
+
+	while (logger->flight_recorders != NULL) {
+		FlightRecorder *recorder = logger->flight_recorders;
+		logger->flight_recorders = recorder->next_recorder;
+		free(recorder);
+	}
+
+	// a thread, which still knows its ring buffer, sees the changed number
+	logger->recorder_capacity = 0;
+	logger->recorder_session = 0;
+}
+
+/// @brief Format a log message on the caller's stack. A longer log message is formatted again into the growable
+///        buffer of this thread or cut, if no memory is left.
+/// @param stack_message buffer of LENGTH_LOG_MESSAGE characters on the caller's stack
+/// @param format the formatted text
+/// @param args the arguments for format
+/// @param message_length receives the length of the log message
+/// @return the formatted log message
+static const char *_format_log_message(Logger *logger, char *stack_message, const char *format, va_list args, size_t *message_length) {
+	char *log_message = stack_message;
+
+	va_list args_2;
+	va_copy(args_2, args);
+	int length = vsnprintf(stack_message, LENGTH_LOG_MESSAGE, format, args);
+
+	if (length < 0) {
+		length = 0;
+		stack_message[0] = '\0';
+	} else if (length >= LENGTH_LOG_MESSAGE) {
+		// a long log message: format it again into the growable buffer of this thread
+		char *long_message = _reserve_thread_buffer(&_long_message_buffer, (size_t)length + 1);
+
+		if (long_message != NULL) {
+			vsnprintf(long_message, (size_t)length + 1, format, args_2);
+			log_message = long_message;
+		} else {
+			length = LENGTH_LOG_MESSAGE - 1;
+			atomic_fetch_add(&logger->truncated_log_events, 1);
+		}
+	}
+
+	va_end(args_2);
+	*message_length = (size_t)length;
+	return log_message;
+}
+
+/// @brief Write one log event, which is handled at the log level, in any mode of the log session.
+/// @param level current log level
+/// @param format the formatted text
+/// @param args the arguments for format
+static void _write_handled_log_event(Logger *logger, LogLevel level, const char *format, va_list args) {
+	if (_enter_async_producer(logger)) {
+		// format the log event directly into a queue slot, the background writer does the rest
+		size_t position;
+		AsyncLogSlot *slot = _async_reserve_slot_by_policy(logger, &position);
+
+		if (slot != NULL && logger->binary_formats != NULL) {
+			// only the raw arguments are copied, the background writer adds the format string, if required
+			slot->binary_length = _encode_binary_record(logger, slot->message, sizeof(slot->message), level, format, args, false);
+			slot->level = level;
+			_async_publish_slot(logger, slot, position);
+		} else if (slot != NULL) {
+			// the size of a slot is fixed, so a longer log message is cut in async mode
+			if (vsnprintf(slot->message, sizeof(slot->message), format, args) >= (int)sizeof(slot->message)) {
+				atomic_fetch_add(&logger->truncated_log_events, 1);
+			}
+
+			slot->binary_length = 0;
+			slot->nbr_of_fields = 0;
+			slot->level = level;
+			_create_new_timestamp(slot->timestamp, atomic_load_explicit(&logger->timestamp_precision, memory_order_relaxed));
+			_async_publish_slot(logger, slot, position);
+		}
+
+		_leave_async_producer(logger);
+		return;
+	}
+
+	if (logger->binary_formats != NULL) {
+		// no formatting at all: the raw arguments are copied into the log file
+		char record[sizeof(BinaryRecordHead) + LENGTH_LOG_MESSAGE];
+
+		_lock_mutex(&logger->file_mutex);
+
+		// the format strings belong to the log session, which may have been ended in the meantime
+		if (logger->binary_formats != NULL) {
+			size_t length = _encode_binary_record(logger, record, sizeof(record), level, format, args, true);
+			_write_binary_record(logger, record, length, level);
+
+			if (!logger->keep_file_open) {
+				_close_log_file(logger);
+			}
+		}
+
+		_unlock_mutex(&logger->file_mutex);
+		return;
+	}
+
+	// formatting happens once on the caller's stack, so only the output itself needs the lock
+	char stack_message[LENGTH_LOG_MESSAGE];
+	size_t message_length;
+	const char *log_message = _format_log_message(logger, stack_message, format, args, &message_length);
+
+	_write_log_message(logger, level, log_message, message_length, NULL, 0, NULL);
+}
+
+/// @brief Handle one log event, which has passed the level check.
+/// @param level current log level
+/// @param format the formatted text
+/// @param args the arguments for format
+static void _write_log_event(Logger *logger, LogLevel level, const char *format, va_list args) {
+	if ((int)level < atomic_load_explicit(&logger->level_for_logging, memory_order_relaxed)) {
+		// only below the log level, if the flight recorder keeps it
+		_record_formatted_log_event(logger, level, format, args);
+		return;
+	}
+
+	if (level >= LOG_ERROR) {
+		_replay_flight_recorder(logger);
+	}
+
+	_write_handled_log_event(logger, level, format, args);
+}
+
+/// @brief Write a log event of the library itself at LOG_WARNING, even if the log level is above it. It's neither kept
+///        by the flight recorder nor does it replay it.
+static void _write_library_warning(Logger *logger, const char *format, ...) {
+	va_list args;
+	va_start(args, format);
+	_write_handled_log_event(logger, LOG_WARNING, format, args);
+	va_end(args);
+}
+
+/// @brief Like _write_log_event(), but with the arguments for format.
+static void _write_formatted_log_event(Logger *logger, LogLevel level, const char *format, ...) {
+	va_list args;
+	va_start(args, format);
+	_write_log_event(logger, level, format, args);
+	va_end(args);
+}
+
+/// @brief Handle one log event from write_to_log_kv(), which has passed the level check.
+/// @param level current log level
+/// @param message the log message
+/// @param fields key and value for each field
+/// @param nbr_of_fields number of pairs in fields
+static void _write_log_fields_event(Logger *logger, LogLevel level, const char *message, const char *const *fields, size_t nbr_of_fields) {
+	if (logger->binary_formats != NULL) {
+		// a binary log file has no fields: they are recorded as text behind the log message
+		char *text = _reserve_thread_buffer(&_fields_text_buffer, _fields_capacity(fields, nbr_of_fields) + 1);
+
+		if (text != NULL) {
+			text[_append_text_fields(text, fields, nbr_of_fields)] = '\0';
+		} else {
+			text = "";
+			atomic_fetch_add(&logger->truncated_log_events, 1);
+		}
+
+		_write_formatted_log_event(logger, level, "%s%s", message, text);
+		return;
+	}
+
+	size_t message_length = strlen(message);
+
+	if ((int)level < atomic_load_explicit(&logger->level_for_logging, memory_order_relaxed)) {
+		// only below the log level, if the flight recorder keeps it; the same layout like in a queue slot
+		char payload[LENGTH_LOG_MESSAGE];
+		size_t copied = message_length < sizeof(payload) ? message_length : sizeof(payload) - 1;
+		memcpy(payload, message, copied);
+		payload[copied] = '\0';
+
+		size_t packed = _pack_fields(payload + copied + 1, sizeof(payload) - copied - 1, fields, nbr_of_fields);
+
+		if (copied < message_length || packed < nbr_of_fields) {
+			atomic_fetch_add(&logger->truncated_log_events, 1);
+		}
+
+		size_t payload_length = copied + 1;
+
+		for (size_t i = 0; i < packed * 2; i++) {
+			payload_length += strlen(payload + payload_length) + 1;
+		}
+
+		_record_log_event(logger, level, payload, payload_length, packed);
+		return;
+	}
+
+	if (level >= LOG_ERROR) {
+		_replay_flight_recorder(logger);
+	}
+
+	if (_enter_async_producer(logger)) {
+		size_t position;
+		AsyncLogSlot *slot = _async_reserve_slot_by_policy(logger, &position);
+
+		if (slot != NULL) {
+			// the log message and the fields share the fixed size of a slot, the log message comes first
+			size_t copied = message_length < sizeof(slot->message) ? message_length : sizeof(slot->message) - 1;
+			memcpy(slot->message, message, copied);
+			slot->message[copied] = '\0';
+
+			slot->nbr_of_fields = _pack_fields(slot->message + copied + 1, sizeof(slot->message) - copied - 1, fields, nbr_of_fields);
+
+			if (copied < message_length || slot->nbr_of_fields < nbr_of_fields) {
+				atomic_fetch_add(&logger->truncated_log_events, 1);
+			}
+
+			slot->binary_length = 0;
+			slot->level = level;
+			_create_new_timestamp(slot->timestamp, atomic_load_explicit(&logger->timestamp_precision, memory_order_relaxed));
+			_async_publish_slot(logger, slot, position);
+		}
+
+		_leave_async_producer(logger);
+		return;
+	}
+
+	_write_log_message(logger, level, message, message_length, fields, nbr_of_fields, NULL);
+}
+
+/// @brief Collect the pairs of key and value of write_to_log_kv() up to the terminating NULL.
+/// @param fields receives key and value for each field; at least MAX_LOG_FIELDS * 2 entries
+/// @param args the arguments behind the log message
+/// @return number of pairs; further pairs than MAX_LOG_FIELDS are ignored
+static size_t _collect_fields(const char **fields, va_list args) {
+	size_t nbr_of_fields = 0;
+	const char *key;
+
+	while (nbr_of_fields < MAX_LOG_FIELDS && (key = va_arg(args, const char *)) != NULL) {
+		const char *value = va_arg(args, const char *);
+
+		fields[nbr_of_fields * 2] = key;
+		fields[nbr_of_fields * 2 + 1] = value != NULL ? value : "(null)";
+		nbr_of_fields++;
+	}
+
+	return nbr_of_fields;
+}
+
+/// @brief Handle one log event of a callsite from LOG_CALLSITE_(), which has passed the level check. The log message
+///        is formatted once, its source location is attached as fields without any formatting.
+/// @param format the formatted text
+/// @param args the arguments for format
+static void _write_callsite_event(Logger *logger, const LogCallsite *callsite, const char *format, va_list args) {
+	const char *fields[] = {"source", callsite->location, "function", callsite->function};
+	char stack_message[LENGTH_LOG_MESSAGE];
+	size_t message_length;
+	const char *log_message = _format_log_message(logger, stack_message, format, args, &message_length);
+
+	_write_log_fields_event(logger, callsite->level, log_message, fields, 2);
+}
+
+/// @brief Count log events, which are suppressed by LOG_SAMPLED_() or a rate limit.
+/// @param level level of the suppressed log events
+/// @param count number of suppressed log events
+static void _count_suppressed_log_events(Logger *logger, LogLevel level, unsigned long long count) {
+	atomic_fetch_add_explicit(&logger->suppressed_by_level[level], count, memory_order_relaxed);
+	atomic_fetch_add_explicit(&logger->suppressed_log_events, count, memory_order_relaxed);
+}
+
+/// @brief Write the number of suppressed log events since the last report, e.g.
+///        "suppressed 1234 log events by sampling or rate limits: DEBUG 1200, TRACE 34"
+///        Only one thread reports each report_interval_in_ms. Nothing is written, if no log event has been suppressed.
+/// @param forced true, if the report is written before the end of report_interval_in_ms, e.g. by dispose()
+static void _report_suppressed_log_events(Logger *logger, bool forced) {
+	long long now = _now_in_ms();
+	long long next = atomic_load_explicit(&logger->next_report_in_ms, memory_order_relaxed);
+
+	if (forced) {
+		atomic_store_explicit(&logger->next_report_in_ms, now + logger->report_interval_in_ms, memory_order_relaxed);
+	} else if (now < next || !atomic_compare_exchange_strong(&logger->next_report_in_ms, &next, now + logger->report_interval_in_ms)) {
+		return;
+	}
+
+	unsigned long long counts[LOG_FATAL + 1];
+	unsigned long long total = 0;
+
+	for (int level = LOG_TRACE; level <= LOG_FATAL; level++) {
+		counts[level] = atomic_exchange_explicit(&logger->suppressed_by_level[level], 0, memory_order_relaxed);
+		total += counts[level];
+	}
+
+	if (total == 0) {
+		return;
+	}
+
+	char report[256];
+	int length = snprintf(report, sizeof(report), "suppressed %llu log events by sampling or rate limits:", total);
+
+	const char *separator = " ";
+
+	for (int level = LOG_FATAL; level >= LOG_TRACE; level--) {
+		if (counts[level] > 0) {
+			length += snprintf(report + length, sizeof(report) - (size_t)length, "%s%s %llu", separator, _level_strings[level], counts[level]);
+			separator = ", ";
+		}
+	}
+
+	// the report itself is written, even if the log level is above LOG_WARNING
+	_write_library_warning(logger, "%s", report);
+}
+
+/// @brief Check the rate limit of a log event, which has passed the level check, before it's formatted.
+///        A suppressed log event is counted. The suppressed log events are reported each report_interval_in_ms.
+/// @param level current log level
+/// @return true, if the log event is going to be written
+static bool _is_rate_allowed(Logger *logger, LogLevel level) {
+	if (
+		!atomic_load_explicit(&logger->rate_limited, memory_order_acquire) ||
+		(int)level < atomic_load_explicit(&logger->level_for_logging, memory_order_relaxed)
+	) {
+		// without a rate limit or only kept by the flight recorder
+		return true;
+	}
+
+	long long interval = logger->rate_interval_in_ns[level];
+
+	if (interval == 0) {
+		_report_suppressed_log_events(logger, false);
+		return true;
+	}
+
+	long long now = _now_in_ns();
+	long long arrival = atomic_load_explicit(&logger->rate_arrival_in_ns[level], memory_order_relaxed);
+	long long start;
+
+	do {
+		start = arrival > now ? arrival : now;
+
+		if (start - now > logger->rate_burst_in_ns[level]) {
+			// the bucket is empty
+			_count_suppressed_log_events(logger, level, 1);
+			_report_suppressed_log_events(logger, false);
+			return false;
+		}
+	} while (!atomic_compare_exchange_weak_explicit(&logger->rate_arrival_in_ns[level], &arrival, start + interval, memory_order_relaxed, memory_order_relaxed));
+
+	_report_suppressed_log_events(logger, false);
+	return true;
+}
+
+/// @brief Final log initializer. The settings are come from init_log_by_arguments() or init_log() function(s).
+/// @param file_name name of the log file; comes separately, since init_log_by_arguments() allows any length
+/// @param settings every other setting for the log session
+static void _internal_log_initializer(Logger *logger, const char *file_name, const Logging *settings) {
+	// the suppressed log events of a previous log session belong to its log file
+	_report_suppressed_log_events(logger, true);
+	_lock_mutex(&logger->config_mutex);
+
+	// a previous log session may still run a writer thread or hold an open file
+	_stop_async_writer(logger);
+	_stop_batch_timer(logger);
+
+	_lock_mutex(&logger->file_mutex);
+	_release_repeat_suppression(logger);
+	_stop_memory_mapping(logger);
+	_release_batch(logger);
+	_release_preallocation(logger);
+	_close_log_file(logger);
+	_release_binary_formats(logger);
+	_release_flight_recorders(logger);
+
+	_stop_config_watch(logger);
+
+	if (logger->background_housekeeping) {
+		_leave_housekeeper();
+		logger->background_housekeeping = false;
+	}
+
+	LogLevel level_for_logging = settings->init_level;
+	int level_warning = 3;
+
+	if (!(level_for_logging >= LOG_TRACE && level_for_logging <= LOG_FATAL)) {                                                     // check for an invalid log level setting
+		fprintf(
+			stderr,
+			"%sWarning: invalid log level setting detected. Set the level to %s default.%s\n",
+			_level_colors[level_warning], _level_strings[2], COLOR_RESET
+		);
+
+		level_for_logging = LOG_INFO;
+	}
+
+	atomic_store(&logger->level_for_logging, level_for_logging);
+
+	if (logger == &_default_logger) {
+		atomic_store(&_level_for_logging, level_for_logging);
+	}
+
+	if (settings->config_file[0] != '\0' && !_watch_config_file(logger, settings)) {                                              // reload the log level and the callsites at runtime
+		fprintf(
+			stderr, "%sWarning: unable to start the background thread. The config file \"%s\" isn't watched.%s\n",
+			_level_colors[level_warning], settings->config_file, COLOR_RESET
+		);
+	}
+
+	if (settings->reload_on_sighup) {                                                                                              // reload the config file by SIGHUP
+		#ifdef _WIN32
+		fprintf(stderr, "%sWarning: SIGHUP isn't available on Windows.%s\n", _level_colors[level_warning], COLOR_RESET);
+		#else
+		if (settings->config_file[0] == '\0') {
+			fprintf(stderr, "%sWarning: reload_on_sighup is only in use with a config_file.%s\n", _level_colors[level_warning], COLOR_RESET);
+		}
+		#endif
+	}
+
+	bool rate_limited = false;
+
+	for (int level = LOG_TRACE; level <= LOG_FATAL; level++) {                                                                     // token bucket for each level with a rate limit
+		int rate = settings->rate_limits[level];
+
+		if (rate < 0) {
+			fprintf(
+				stderr, "%sWarning: invalid rate limit for %s detected. The level isn't limited.%s\n",
+				_level_colors[level_warning], _level_strings[level], COLOR_RESET
+			);
+			rate = 0;
+		}
+
+		// up to one second of log events at once, afterwards one log event each interval
+		long long interval = rate > 0 ? 1000000000LL / rate : 0;
+		interval = rate > 0 && interval == 0 ? 1 : interval;
+		logger->rate_interval_in_ns[level] = interval;
+		logger->rate_burst_in_ns[level] = rate > 0 ? (rate - 1) * interval : 0;
+		atomic_store(&logger->rate_arrival_in_ns[level], 0);
+		rate_limited = rate_limited || rate > 0;
+	}
+
+	logger->report_interval_in_ms = settings->suppression_report_interval_in_ms < 1 ? DEFAULT_SUPPRESSION_REPORT_INTERVAL_IN_MS : settings->suppression_report_interval_in_ms;
+	atomic_store(&logger->next_report_in_ms, _now_in_ms() + logger->report_interval_in_ms);
+	atomic_store_explicit(&logger->rate_limited, rate_limited, memory_order_release);
+
+	LogTimestampPrecision timestamp_precision = settings->timestamp_precision;
+
+	if (!(timestamp_precision >= TIMESTAMP_SECONDS && timestamp_precision <= TIMESTAMP_NANOSECONDS)) {                             // check for an invalid timestamp precision
+		fprintf(
+			stderr, "%sWarning: invalid timestamp precision detected. Using TIMESTAMP_SECONDS instead.%s\n",
+			_level_colors[level_warning], COLOR_RESET
+		);
+		timestamp_precision = TIMESTAMP_SECONDS;
+	}
+
+	atomic_store(&logger->timestamp_precision, timestamp_precision);
+	logger->on_console_only = false;
+	logger->keep_file_open = false;
+
+	if (settings->on_console_only) {
+		logger->on_console_only = true;
+		_unlock_mutex(&logger->file_mutex);
+
+		atomic_store_explicit(&logger->initializing_done, true, memory_order_release);
+		_unlock_mutex(&logger->config_mutex);
+		return;
+	}
+
+	// file handling options are selected
+	logger->nbr_of_keeping_files = (settings->nbr_of_keeping_files - 1);                                                          // nbr of files to keep
+	logger->size_for_file_size = 1024LL * 1024LL * settings->file_size_in_mb;                                                      // 1024*1024*size_in_mb
+
+	switch(settings->rotation_setting) {
+		case NO_ROTATION:    // = 0
+			logger->log_rotation = NO_ROTATION;
+			break;
+		case DAILY_ROTATION: // = 1
+			logger->log_rotation = DAILY_ROTATION;
+			break;
+		case SIZE_ROTATION:  // = 2
+			logger->log_rotation = SIZE_ROTATION;
+			break;
+		default:
+			// rotation is outside of [NO_ROTATION..SIZE_ROTATION] or UNSET_ROTATION
+			fprintf(
+				stderr, "%sWarning: Rotation setting is not defined. Using rotation type \"%s\" instead.\n%s",
+				_level_colors[level_warning], _rotation_strings[0], COLOR_RESET
+			);
+
+			logger->log_rotation = NO_ROTATION;
+			break;
+	}
+
+	// null terminating file name
+	memset(logger->log_file_to_use, '\0', sizeof(logger->log_file_to_use));
+
+	if (file_name == NULL) {                                                                                                       // check, if the file name points to NULL
+		fprintf(
+			stderr, "%sWarning: Invalid file name detected. Using \"%s\" as file name instead.\n%s",
+			_level_colors[level_warning], _default_log_name, COLOR_RESET
+		);
+
+		strcpy(logger->log_file_to_use, _default_log_name);
+	} else {
+		size_t name_length = strlen(file_name);
+
+		if (name_length > 0 && name_length < LENGTH_FILE_NAME) {                                                                   // check for valid file size length [1..31]
+			strcpy(logger->log_file_to_use, file_name);
+		} else {
+			fprintf(
+				stderr,
+				"%sWarning: Invalid length (%d) for file name detected. Using a default file name \"%s\" instead.%s\n",
+				_level_colors[level_warning], (int) name_length, _default_log_name, COLOR_RESET
+			);
+			strcpy(logger->log_file_to_use, _default_log_name);
+		}
+	}
+
+	if (logger->log_rotation != NO_ROTATION) {                                                                                     // special handling for DAILY_ROTATION and SIZE_ROTATION
+		if (logger->size_for_file_size < 1 && logger->log_rotation == SIZE_ROTATION) {                                             // check for invalid SIZE_ROTATION setting
+			fprintf(
+				stderr,
+				"%sWarning: Invalid size in MB for for option %s detected. Switching to option \"%s\" instead.%s\n",
+				_level_colors[level_warning], _rotation_strings[2], _rotation_strings[0], COLOR_RESET
+			);
+
+			logger->log_rotation = NO_ROTATION;
+		}
+
+		if (logger->nbr_of_keeping_files < 2) {                                                                                    // check for invalid keep_nbr_files setting
+			fprintf(
+				stderr,
+				"%sWarning: invalid number of keeping files detected: %d. Using 2 files to keep up by default.%s\n",
+				_level_colors[level_warning], settings->nbr_of_keeping_files, COLOR_RESET
+			);
+			logger->nbr_of_keeping_files = 2;
+		}
+	}
+
+	LogRotationNaming rotation_naming = settings->rotation_naming;
+
+	if (!(rotation_naming >= NAMING_SHIFT && rotation_naming <= NAMING_SEQUENCE)) {                                                // check for an invalid naming of rotated files
+		fprintf(
+			stderr, "%sWarning: invalid naming for rotated files detected. Using NAMING_SHIFT instead.%s\n",
+			_level_colors[level_warning], COLOR_RESET
+		);
+		rotation_naming = NAMING_SHIFT;
+	}
+
+	logger->rotation_naming = rotation_naming;
+
+	logger->compress_rotated_files = false;
+
+	if (settings->compress_rotated_files && logger->log_rotation != NO_ROTATION) {                                               // compress rotated files in the background
+		#ifdef LOG_WITH_ZLIB
+		logger->compress_rotated_files = true;
+		#else
+		fprintf(
+			stderr, "%sWarning: compression of rotated files isn't built in (LOG_WITH_ZLIB). Rotated files stay uncompressed.%s\n",
+			_level_colors[level_warning], COLOR_RESET
+		);
+		#endif
+	}
+
+	if ((settings->background_housekeeping || logger->compress_rotated_files) && logger->log_rotation != NO_ROTATION) {         // rename and remove rotated files in the background
+		logger->background_housekeeping = _use_housekeeper();
+		logger->compress_rotated_files = logger->compress_rotated_files && logger->background_housekeeping;
+
+		if (!logger->background_housekeeping) {
 			fprintf(
-				stderr,
-				"%sWarning: invalid number of keeping files detected: %d. Using 2 files to keep up by default.%s\n",
-				_level_colors[level_warning], keep_nbr_files, COLOR_RESET
+				stderr, "%sWarning: unable to start the housekeeping thread. Rotated files are handled on the caller's thread instead.%s\n",
+				_level_colors[level_warning], COLOR_RESET
+			);
+		}
+	}
+
+	if (logger->log_rotation != NO_ROTATION) {
+		_seed_rotation_state(logger);
+	}
+
+	logger->keep_file_open = settings->keep_file_open;
+	logger->preallocate_files = settings->preallocate_files && logger->log_rotation == SIZE_ROTATION;
+	logger->memory_mapped_files = false;
+
+	if (settings->binary_format) {                                                                                                 // record raw arguments instead of log lines
+		logger->binary_formats = calloc(LOG_BINARY_FORMATS, sizeof(BinaryFormat));
+		logger->binary_file_number = 1;
+
+		if (logger->binary_formats == NULL) {
+			fprintf(
+				stderr, "%sWarning: unable to create the table of format strings. Log lines are written as text instead.%s\n",
+				_level_colors[level_warning], COLOR_RESET
+			);
+		}
+	}
+
+	logger->json_lines = false;
+
+	if (settings->json_lines) {                                                                                                    // write each log event as JSON object
+		if (logger->binary_formats != NULL) {
+			fprintf(
+				stderr, "%sWarning: JSON lines aren't in use with binary_format.%s\n",
+				_level_colors[level_warning], COLOR_RESET
+			);
+		} else {
+			logger->json_lines = true;
+		}
+	}
+
+	if (settings->flight_recorder) {                                                                                               // keep log events below the log level
+		LogLevel recorder_level = settings->flight_recorder_level;
+		int size_in_kb = settings->flight_recorder_size_in_kb < 1 ? DEFAULT_FLIGHT_RECORDER_SIZE_IN_KB : settings->flight_recorder_size_in_kb;
+
+		if (logger->binary_formats != NULL) {
+			fprintf(
+				stderr, "%sWarning: the flight recorder isn't in use with binary_format.%s\n",
+				_level_colors[level_warning], COLOR_RESET
+			);
+		} else if (!(recorder_level >= LOG_TRACE && recorder_level < level_for_logging)) {
+			fprintf(
+				stderr, "%sWarning: the level of the flight recorder must be below the log level. The flight recorder isn't in use.%s\n",
+				_level_colors[level_warning], COLOR_RESET
+			);
+		} else {
+			logger->recorder_capacity = (size_t)size_in_kb * 1024;
+			logger->recorder_session = atomic_fetch_add(&_flight_recorder_sessions, 1) + 1;
+			atomic_store(&logger->recorder_level, recorder_level);
+
+			// the config file may have set another log level already
+			_set_logger_level(logger, (LogLevel)atomic_load(&logger->level_for_logging));
+		}
+	}
+
+	if (settings->memory_mapped_files) {                                                                                           // copy log lines into the mapped log file
+		if (logger->binary_formats != NULL) {
+			fprintf(
+				stderr, "%sWarning: memory mapped files aren't in use with binary_format.%s\n",
+				_level_colors[level_warning], COLOR_RESET
+			);
+		} else if (logger->log_rotation != SIZE_ROTATION) {
+			fprintf(
+				stderr, "%sWarning: memory mapped files are only in use for %s.%s\n",
+				_level_colors[level_warning], _rotation_strings[2], COLOR_RESET
+			);
+		} else if (!_start_memory_mapping(logger)) {
+			fprintf(
+				stderr, "%sWarning: unable to map the log file \"%s\" into the memory. Log lines are written as usual.%s\n",
+				_level_colors[level_warning], logger->log_file_to_use, COLOR_RESET
+			);
+		} else {
+			// the mapping replaces every other way of writing
+			logger->memory_mapped_files = true;
+			logger->preallocate_files = false;
+		}
+	}
+
+	if (settings->suppress_repeated_messages) {                                                                                    // count repeated log messages instead of writing them
+		if (logger->binary_formats != NULL || logger->memory_mapped_files) {
+			fprintf(
+				stderr, "%sWarning: repeated log messages aren't suppressed with binary_format or memory_mapped_files.%s\n",
+				_level_colors[level_warning], COLOR_RESET
+			);
+		} else {
+			logger->repeat_window_in_ms = settings->repeat_window_in_ms < 1 ? DEFAULT_REPEAT_WINDOW_IN_MS : settings->repeat_window_in_ms;
+		}
+	}
+
+	if ((settings->batch_mode || settings->io_uring_files) && !logger->memory_mapped_files) {                                       // collect log lines and write them at once
+		int batch_size_in_kb = settings->batch_size_in_kb < 1 ? DEFAULT_BATCH_SIZE_IN_KB : settings->batch_size_in_kb;
+		logger->flush_interval_in_ms = settings->flush_interval_in_ms < 1 ? DEFAULT_FLUSH_INTERVAL_IN_MS : settings->flush_interval_in_ms;
+		logger->next_flush_in_ms = _now_in_ms() + logger->flush_interval_in_ms;
+		logger->batch_capacity = (size_t)batch_size_in_kb * 1024;
+
+		if (settings->io_uring_files) {                                                                                            // submit the batches to io_uring
+			#ifdef LOG_WITH_IO_URING
+			logger->ring = _create_ring(logger->batch_capacity);
+
+			if (logger->ring != NULL) {
+				// the batches in flight need an open log file
+				logger->batch_buffer = logger->ring->batches[0];
+				logger->keep_file_open = true;
+			}
+			#endif
+
+			if (logger->ring == NULL) {
+				fprintf(
+					stderr, "%sWarning: io_uring isn't available. The batches are written by the log session instead.%s\n",
+					_level_colors[level_warning], COLOR_RESET
+				);
+			}
+		}
+
+		if (logger->ring == NULL) {
+			logger->batch_buffer = malloc(logger->batch_capacity);
+		}
+
+		if (logger->batch_buffer == NULL) {
+			fprintf(
+				stderr, "%sWarning: unable to create the batch of %d KB. Log lines are written one by one instead.%s\n",
+				_level_colors[level_warning], batch_size_in_kb, COLOR_RESET
+			);
+
+			logger->batch_capacity = 0;
+		} else if (!settings->async_mode && !_start_batch_timer(logger)) {
+			fprintf(
+				stderr, "%sWarning: unable to start the background thread. The batch is written by the next log event instead.%s\n",
+				_level_colors[level_warning], COLOR_RESET
+			);
+		}
+	}
+
+	if (logger->keep_file_open && !_open_log_file(logger)) {                                                                       // open the file once for the whole log session
+		fprintf(
+			stderr, "%sWarning: unable to open the log file \"%s\": %s. Trying again with the next log event.%s\n",
+			_level_colors[level_warning], logger->log_file_to_use, strerror(errno), COLOR_RESET
+		);
+	}
+
+	_unlock_mutex(&logger->file_mutex);
+	atomic_store(&logger->dropped_log_events, 0);
+	atomic_store(&logger->truncated_log_events, 0);
+	atomic_store(&logger->suppressed_log_events, 0);
+
+	for (int level = LOG_TRACE; level <= LOG_FATAL; level++) {
+		atomic_store(&logger->suppressed_by_level[level], 0);
+	}
+
+	if (settings->async_mode) {                                                                                                    // hand over the file writing to a background thread
+		LogOverflowPolicy policy = settings->overflow_policy;
+
+		if (!(policy >= OVERFLOW_BLOCK && policy <= OVERFLOW_DROP_OLDEST)) {                                                       // check for an invalid overflow policy
+			fprintf(
+				stderr, "%sWarning: invalid overflow policy detected. Using OVERFLOW_BLOCK instead.%s\n",
+				_level_colors[level_warning], COLOR_RESET
+			);
+			policy = OVERFLOW_BLOCK;
+		}
+
+		int queue_size = settings->async_queue_size < 2 ? DEFAULT_ASYNC_QUEUE_SIZE : settings->async_queue_size;
+
+		if (!_start_async_writer(logger, queue_size, policy)) {
+			fprintf(
+				stderr, "%sWarning: unable to start the background writer. Log events are written on the caller's thread instead.%s\n",
+				_level_colors[level_warning], COLOR_RESET
 			);
-			_nbr_of_keeping_files = 2;
 		}
 	}
 
-	// in use for dayly rotation
-	strcpy(_base_log_file, _log_file_to_use);
-	_initializing_done = true;
+	atomic_store_explicit(&logger->initializing_done, true, memory_order_release);
+	_unlock_mutex(&logger->config_mutex);
+}
+
+/// @brief Check, if a log event with the given level is going to be handled by the log session.
+///        An error message is printed, if the log session hasn't been initialized.
+static bool _is_level_handled(Logger *logger, LogLevel level) {
+	if (
+		(int)level < atomic_load_explicit(&logger->level_for_logging, memory_order_relaxed) &&
+		(int)level < atomic_load_explicit(&logger->recorder_level, memory_order_relaxed)
+	) {
+		// every level, which has a lower value compared to the initial level
+		// and isn't kept by the flight recorder won't be handled
+		return false;
+	}
+
+	if (!atomic_load_explicit(&logger->initializing_done, memory_order_acquire)) {
+		fprintf(
+			stderr, "%sERROR: No log handling is going to do since no init function before has been called.\n%s",
+			_level_colors[5], COLOR_RESET
+		);
+		return false;
+	}
+
+	return true;
+}
+
+/// @brief Stop the background writer of a log session, if any, write the remaining batch and close its log file.
+static void _dispose_logger(Logger *logger) {
+	_report_suppressed_log_events(logger, true);
+	_lock_mutex(&logger->config_mutex);
+	_stop_async_writer(logger);
+	_stop_batch_timer(logger);
+
+	_lock_mutex(&logger->file_mutex);
+	_release_repeat_suppression(logger);
+	_stop_memory_mapping(logger);
+	_release_batch(logger);
+	_release_preallocation(logger);
+	_close_log_file(logger);
+	_release_flight_recorders(logger);
+
+	// a log event afterwards reopens the log file, so the format strings are kept and written again into it
+	logger->binary_file_number++;
+
+	// every rotated file is at its final place afterwards
+	_stop_config_watch(logger);
+
+	if (logger->background_housekeeping) {
+		_leave_housekeeper();
+		logger->background_housekeeping = false;
+	}
+
+	_unlock_mutex(&logger->file_mutex);
+
+	_unlock_mutex(&logger->config_mutex);
 }
 
 // -----------
@@ -460,89 +5032,381 @@ static void _internal_log_initializer(const char *file_name, const LogLevel init
 // -----------
 
 void init_log_by_arguments(const char *file_name, const LogLevel init_level, const LogRotation rotation, int size_in_mb, int keep_nbr_files, bool on_console) {
-	_internal_log_initializer(file_name, init_level, rotation, size_in_mb, keep_nbr_files, on_console);
+	Logging settings = {
+		.init_level = init_level,
+		.rotation_setting = rotation,
+		.file_size_in_mb = size_in_mb,
+		.nbr_of_keeping_files = keep_nbr_files,
+		.on_console_only = on_console
+	};
+
+	_internal_log_initializer(&_default_logger, file_name, &settings);
 }
 
 void init_log(Logging *log) {
 	if (log == NULL) {
-		_internal_log_initializer("", LOG_INFO, NO_ROTATION, 0, 0, true);                                                          // redirect the log output to stdout instead
+		Logging settings = {
+			.init_level = LOG_INFO,
+			.rotation_setting = NO_ROTATION,
+			.on_console_only = true                                                                                                // redirect the log output to stdout instead
+		};
+
+		_internal_log_initializer(&_default_logger, "", &settings);
 	} else {
-		_internal_log_initializer(log->file_name, log->init_level, log->rotation_setting, log->file_size_in_mb, log->nbr_of_keeping_files, log->on_console_only);
+		_internal_log_initializer(&_default_logger, log->file_name, log);
 	}
 }
 
 void write_to_log(LogLevel level, const char* format, ...) {
-	if (level < _level_for_logging) {
-		// every level, which has a lower value compared to the initial level
-		// won't be handled
+	Logger *logger = &_default_logger;
+
+	if (!_is_level_handled(logger, level) || !_is_rate_allowed(logger, level)) {
 		return;
 	}
 
-	if (!_initializing_done) {
-		fprintf(
-			stderr, "%sERROR: No log handling is going to do since no init function before has been called.\n%s",
-			_level_colors[5], COLOR_RESET
-		);
+	va_list args;
+	va_start(args, format);
+	_write_log_event(logger, level, format, args);
+	va_end(args);
+}
+
+void write_to_log_kv(LogLevel level, const char *message, ...) {
+	Logger *logger = &_default_logger;
+
+	if (!_is_level_handled(logger, level) || !_is_rate_allowed(logger, level)) {
 		return;
 	}
 
-	char log_line[LENGTH_LOG_MESSAGE];
-	memset(log_line, '\0', sizeof(log_line));
-
+	const char *fields[MAX_LOG_FIELDS * 2];
 	va_list args;
-	va_start(args, format);
-	vsnprintf(log_line, sizeof(log_line), format, args);
+	va_start(args, message);
+	size_t nbr_of_fields = _collect_fields(fields, args);
 	va_end(args);
 
-	_create_new_timestamp();
+	_write_log_fields_event(logger, level, message != NULL ? message : "(null)", fields, nbr_of_fields);
+}
 
-	if (_on_console_only) {
-		fprintf(
-			stdout, "[%s] %s[%s]%s ",
-			_timestamp, _level_colors[level], _log_level_to_string(level), COLOR_RESET
-		);
+void set_log_level(LogLevel level) {
+	set_logger_level(&_default_logger, level);
+}
 
-		va_list args_2;
-		va_start(args_2, format);
-		vfprintf(stdout, format, args_2);
-		va_end(args_2);
+LogLevel get_log_level(void) {
+	return (LogLevel)atomic_load_explicit(&_default_logger.level_for_logging, memory_order_relaxed);
+}
+
+bool reload_log_config(const char *file_name) {
+	return file_name != NULL && _apply_log_config(&_default_logger, file_name);
+}
+
+void write_to_log_sampled(LogLevel level, unsigned int skipped, const char *format, ...) {
+	Logger *logger = &_default_logger;
 
-		fprintf(stdout, "\n");
+	if (!_is_level_handled(logger, level)) {
 		return;
 	}
 
-	_log_file_pointer = fopen(_log_file_to_use, "a");
-	bool on_valid_file_pointer = _log_file_pointer != NULL;
+	if (skipped > 0) {
+		_count_suppressed_log_events(logger, level, skipped);
+		_report_suppressed_log_events(logger, false);
+	}
 
-	if (!on_valid_file_pointer) {
-		fprintf(stderr, "%sERROR: unable to write the log file...%s: %s\n", _level_colors[4], COLOR_RESET, strerror(errno));
+	if (!_is_rate_allowed(logger, level)) {
 		return;
 	}
 
-	if (_log_rotation != NO_ROTATION) {
-		// close this file stream and check, depending on which rotation is set,
-		// if a file rotation is required
-		dispose();
+	va_list args;
+	va_start(args, format);
+	_write_log_event(logger, level, format, args);
+	va_end(args);
+}
+
+void write_to_log_at(const LogCallsite *callsite, const char *format, ...) {
+	Logger *logger = &_default_logger;
+
+	if (callsite == NULL || !_is_level_handled(logger, callsite->level) || !_is_rate_allowed(logger, callsite->level)) {
+		return;
+	}
 
-		if (_check_for_new_rotation()) {
-			(_log_rotation == DAILY_ROTATION) ? _rotate_log_file_daily() : _rotate_log_files();
+	va_list args;
+	va_start(args, format);
+	_write_callsite_event(logger, callsite, format, args);
+	va_end(args);
+}
+
+bool register_log_callsite(LogCallsite *callsite) {
+	_lock_mutex(&_callsite_mutex);
+
+	// another thread may have registered the callsite in the meantime
+	if (atomic_load_explicit(&callsite->state, memory_order_relaxed) == CALLSITE_UNREGISTERED) {
+		bool enabled = true;
+
+		for (int i = 0; i < _nbr_of_callsite_rules; i++) {
+			if (_is_callsite_matching(callsite, &_callsite_rules[i])) {
+				enabled = _callsite_rules[i].enabled && callsite->level >= _callsite_rules[i].min_level;
+			}
 		}
 
-		_log_file_pointer = fopen(_log_file_to_use, "a");
-		on_valid_file_pointer = _log_file_pointer != NULL;
+		callsite->next = _log_callsites;
+		_log_callsites = callsite;
+		atomic_store_explicit(&callsite->state, enabled ? CALLSITE_ENABLED : CALLSITE_DISABLED, memory_order_release);
+	}
+
+	bool enabled = atomic_load_explicit(&callsite->state, memory_order_relaxed) == CALLSITE_ENABLED;
+	_unlock_mutex(&_callsite_mutex);
+	return enabled;
+}
+
+int set_log_callsites_enabled(const char *file, int line, bool enabled) {
+	return _add_callsite_rule(file, line, enabled, LOG_TRACE);
+}
+
+int set_log_callsites_level(const char *file, LogLevel level) {
+	int level_warning = 3;
+
+	if (!(level >= LOG_TRACE && level <= LOG_FATAL)) {
+		fprintf(stderr, "%sWarning: invalid log level for callsites detected. Nothing is changed.%s\n", _level_colors[level_warning], COLOR_RESET);
+		return 0;
+	}
+
+	return _add_callsite_rule(file, 0, true, level);
+}
+
+void visit_log_callsites(void (*visit)(const LogCallsite *callsite, void *context), void *context) {
+	if (visit == NULL) {
+		return;
 	}
 
-	// handle only logging events, when a file pointer exists
-	if (on_valid_file_pointer) {
-		fprintf(_log_file_pointer, "[%s] [%s] %s\n", _timestamp, _log_level_to_string(level), log_line);
+	_lock_mutex(&_callsite_mutex);
+
+	for (const LogCallsite *callsite = _log_callsites; callsite != NULL; callsite = callsite->next) {
+		visit(callsite, context);
 	}
 
-	dispose();
+	_unlock_mutex(&_callsite_mutex);
+}
+
+unsigned long long get_dropped_log_events(void) {
+	return atomic_load(&_default_logger.dropped_log_events);
+}
+
+unsigned long long get_truncated_log_events(void) {
+	return atomic_load(&_default_logger.truncated_log_events);
+}
+
+unsigned long long get_suppressed_log_events(void) {
+	return atomic_load(&_default_logger.suppressed_log_events);
 }
 
 void dispose(void) {
-	if (_log_file_pointer != NULL) {
-		fclose(_log_file_pointer);
-		_log_file_pointer = NULL;
+	_dispose_logger(&_default_logger);
+	_release_thread_buffers();
+}
+
+Logger *create_logger(const Logging *log) {
+	Logger *logger = calloc(1, sizeof(Logger));
+
+	if (logger == NULL) {
+		fprintf(stderr, "%sERROR: Unable to create a new log session: %s%s\n", _level_colors[5], strerror(errno), COLOR_RESET);
+		return NULL;
+	}
+
+	_init_mutex(&logger->config_mutex);
+	_init_mutex(&logger->file_mutex);
+	atomic_init(&logger->level_for_logging, LOG_INFO);
+	atomic_init(&logger->recorder_level, LOG_RECORDER_INACTIVE);
+	atomic_init(&logger->current_mapped_segment, -1);
+	logger->log_rotation = UNSET_ROTATION;
+	logger->size_for_file_size = 1024 * 1024;
+	logger->nbr_of_keeping_files = 1;
+
+	if (log == NULL) {
+		Logging settings = {
+			.init_level = LOG_INFO,
+			.rotation_setting = NO_ROTATION,
+			.on_console_only = true
+		};
+
+		_internal_log_initializer(logger, "", &settings);
+	} else {
+		_internal_log_initializer(logger, log->file_name, log);
+	}
+
+	return logger;
+}
+
+void write_to_logger(Logger *logger, LogLevel level, const char *format, ...) {
+	if (logger == NULL) {
+		fprintf(stderr, "%sERROR: No log handling is going to do since the log session points to NULL.\n%s", _level_colors[5], COLOR_RESET);
+		return;
+	}
+
+	if (!_is_level_handled(logger, level) || !_is_rate_allowed(logger, level)) {
+		return;
+	}
+
+	va_list args;
+	va_start(args, format);
+	_write_log_event(logger, level, format, args);
+	va_end(args);
+}
+
+void write_to_logger_kv(Logger *logger, LogLevel level, const char *message, ...) {
+	if (logger == NULL) {
+		fprintf(stderr, "%sERROR: No log handling is going to do since the log session points to NULL.\n%s", _level_colors[5], COLOR_RESET);
+		return;
+	}
+
+	if (!_is_level_handled(logger, level) || !_is_rate_allowed(logger, level)) {
+		return;
+	}
+
+	const char *fields[MAX_LOG_FIELDS * 2];
+	va_list args;
+	va_start(args, message);
+	size_t nbr_of_fields = _collect_fields(fields, args);
+	va_end(args);
+
+	_write_log_fields_event(logger, level, message != NULL ? message : "(null)", fields, nbr_of_fields);
+}
+
+void set_logger_level(Logger *logger, LogLevel level) {
+	int level_warning = 3;
+
+	if (logger == NULL) {
+		fprintf(stderr, "%sERROR: No log level is going to set since the log session points to NULL.\n%s", _level_colors[5], COLOR_RESET);
+		return;
+	}
+
+	if (!(level >= LOG_TRACE && level <= LOG_FATAL)) {
+		fprintf(stderr, "%sWarning: invalid log level setting detected. The log level isn't changed.%s\n", _level_colors[level_warning], COLOR_RESET);
+		return;
+	}
+
+	_set_logger_level(logger, level);
+}
+
+unsigned long long get_logger_dropped_log_events(const Logger *logger) {
+	return logger == NULL ? 0 : atomic_load(&logger->dropped_log_events);
+}
+
+unsigned long long get_logger_truncated_log_events(const Logger *logger) {
+	return logger == NULL ? 0 : atomic_load(&logger->truncated_log_events);
+}
+
+unsigned long long get_logger_suppressed_log_events(const Logger *logger) {
+	return logger == NULL ? 0 : atomic_load(&logger->suppressed_log_events);
+}
+
+void destroy_logger(Logger *logger) {
+	if (logger == NULL) {
+		return;
+	}
+
+	_dispose_logger(logger);
+
+	_lock_mutex(&logger->file_mutex);
+	_release_binary_formats(logger);
+	_unlock_mutex(&logger->file_mutex);
+
+	_destroy_mutex(&logger->file_mutex);
+	_destroy_mutex(&logger->config_mutex);
+	free(logger);
+}
+
+bool decode_binary_log(const char *file_name, FILE *output) {
+	FILE *file = file_name == NULL ? NULL : fopen(file_name, "rb");
+	char magic[sizeof(LOG_BINARY_MAGIC) - 1];
+
+	if (file == NULL) {
+		fprintf(stderr, "%sERROR: unable to open the binary log file \"%s\": %s%s\n", _level_colors[4], file_name == NULL ? "(null)" : file_name, strerror(errno), COLOR_RESET);
+		return false;
+	}
+
+	if (fread(magic, 1, sizeof(magic), file) != sizeof(magic) || memcmp(magic, LOG_BINARY_MAGIC, sizeof(magic)) != 0) {
+		fprintf(stderr, "%sERROR: \"%s\" isn't a binary log file.%s\n", _level_colors[4], file_name, COLOR_RESET);
+		fclose(file);
+		return false;
+	}
+
+	// the format strings of the log file by their number
+	char **formats = calloc(LOG_BINARY_FORMATS, sizeof(char *));
+	ThreadBuffer record = {0};
+	ThreadBuffer message = {0};
+	ThreadBuffer text = {0};
+	ThreadBuffer line = {0};
+	BinaryRecordHead head;
+	bool valid = formats != NULL;
+
+	while (valid && fread(&head, sizeof(head), 1, file) == 1) {
+		// the unused rest of a log file, which hasn't been cut
+		if (head.type == 0) {
+			break;
+		}
+
+		char *payload = _reserve_thread_buffer(&record, (size_t)head.length + 1);
+
+		if (payload == NULL || fread(payload, 1, head.length, file) != head.length) {
+			valid = false;
+			break;
+		}
+
+		payload[head.length] = '\0';
+
+		if (head.type == BINARY_RECORD_FORMAT) {
+			// a following log session in the same log file may use the same number for another format string
+			valid = head.format_id < LOG_BINARY_FORMATS;
+
+			if (valid) {
+				free(formats[head.format_id]);
+				formats[head.format_id] = malloc((size_t)head.length + 1);
+				valid = formats[head.format_id] != NULL;
+			}
+
+			if (valid) {
+				memcpy(formats[head.format_id], payload, (size_t)head.length + 1);
+			}
+
+			continue;
+		}
+
+		const char *log_message = payload;
+		size_t message_length = head.length;
+
+		if (head.type == BINARY_RECORD_EVENT) {
+			valid = head.format_id < LOG_BINARY_FORMATS && formats[head.format_id] != NULL &&
+				_decode_binary_arguments(formats[head.format_id], payload, head.length, &message, &text, &message_length);
+			log_message = message.data;
+		} else {
+			valid = head.type == BINARY_RECORD_TEXT;
+		}
+
+		char timestamp[LENGTH_PRECISE_TIMESTAMP];
+		struct timespec when = {.tv_sec = (time_t)head.seconds, .tv_nsec = head.nanoseconds};
+		char *output_line = valid ? _reserve_thread_buffer(&line, LENGTH_LOG_LINE_OVERHEAD + message_length) : NULL;
+
+		if (output_line == NULL) {
+			valid = false;
+			break;
+		}
+
+		_format_timestamp(timestamp, &when, (LogTimestampPrecision)head.precision);
+		size_t length = _compose_log_line(output_line, timestamp, (LogLevel)head.level, log_message, message_length, false);
+		fwrite(output_line, 1, length, output);
+	}
+
+	if (!valid) {
+		fprintf(stderr, "%sERROR: the binary log file \"%s\" is damaged.%s\n", _level_colors[4], file_name, COLOR_RESET);
 	}
-}
\ No newline at end of file
+
+	for (size_t i = 0; formats != NULL && i < LOG_BINARY_FORMATS; i++) {
+		free(formats[i]);
+	}
+
+	free(formats);
+	free(record.data);
+	free(message.data);
+	free(text.data);
+	free(line.data);
+	fclose(file);
+	return valid;
+}
@@ -20,26 +20,51 @@
 *
 * @author    itworks4u
 * @created   October 12th, 2025
-* @updated   March 27th, 2026
-* @version   1.3.0
+* @updated   October 16th, 2026
+* @version   1.4.0
 */
 
 #ifndef LOGGING_H
 #define LOGGING_H
+#include <stdio.h>
 #include <stdbool.h>
+#include <stdatomic.h>
 
 // -----------
 // definitions
 // -----------
 
-#define CURRENT_VERSION          "1.3.0"
+#define CURRENT_VERSION          "1.4.0"
 #define LENGTH_TIMESTAMP         20
+#define LENGTH_PRECISE_TIMESTAMP 30
 #define LENGTH_TIMESTAMP_BUFFER  256
 #define LENGTH_LOG_MESSAGE       1024
 #define LENGTH_FILE_NAME         32
 #define SHORT_TIMESTAMP_LENGTH   11
 #define FILE_NAME_LOG_ROTATION   512
 #define LENGTH_DATE_STAMP        16
+#define DEFAULT_ASYNC_QUEUE_SIZE 1024
+#define DEFAULT_BATCH_SIZE_IN_KB 64
+#define DEFAULT_FLUSH_INTERVAL_IN_MS 1000
+#define MAX_LOG_FIELDS           32
+#define DEFAULT_FLIGHT_RECORDER_SIZE_IN_KB 64
+#define DEFAULT_REPEAT_WINDOW_IN_MS 10000
+#define DEFAULT_SUPPRESSION_REPORT_INTERVAL_IN_MS 10000
+#define MAX_LOG_CALLSITE_RULES   64
+#define DEFAULT_CONFIG_CHECK_INTERVAL_IN_MS 1000
+
+// lets the compiler check the terminating NULL of write_to_log_kv() and write_to_logger_kv()
+#if defined(__GNUC__) || defined(__clang__)
+#define LOG_SENTINEL             __attribute__((sentinel))
+#else
+#define LOG_SENTINEL
+#endif
+
+// minimal log level for the LOG_*_() macros at compile time: 0 = TRACE .. 5 = FATAL, 6 = nothing
+// every macro below this level compiles to nothing, e.g. build with -DLOG_MIN_LEVEL=2 for a release
+#ifndef LOG_MIN_LEVEL
+#define LOG_MIN_LEVEL            0
+#endif
 
 // reset the text color to the default value
 #define COLOR_RESET              "\x1b[0m"
@@ -67,6 +92,51 @@ typedef enum {
 	UNSET_ROTATION
 } LogRotation;
 
+/// @brief Naming of the rotated files. Works only for DAILY_ROTATION and SIZE_ROTATION.
+///        NAMING_SHIFT    := output.log.1 is the newest rotated file; each rotation renames every rotated file
+///        NAMING_SEQUENCE := output.log.000123 with an increasing number; each rotation renames only the current
+///                           log file and removes only the oldest rotated file
+typedef enum {
+	NAMING_SHIFT,
+	NAMING_SEQUENCE
+} LogRotationNaming;
+
+/// @brief Precision of the timestamp for each log event.
+typedef enum {
+	TIMESTAMP_SECONDS,
+	TIMESTAMP_MILLISECONDS,
+	TIMESTAMP_MICROSECONDS,
+	TIMESTAMP_NANOSECONDS
+} LogTimestampPrecision;
+
+/// @brief Behavior for async mode, when the queue for the background writer is full.
+typedef enum {
+	OVERFLOW_BLOCK,
+	OVERFLOW_DROP_NEWEST,
+	OVERFLOW_DROP_OLDEST
+} LogOverflowPolicy;
+
+/// @brief State of a callsite from LOG_CALLSITE_(). A callsite is registered by its first handled call.
+typedef enum {
+	CALLSITE_UNREGISTERED,
+	CALLSITE_ENABLED,
+	CALLSITE_DISABLED
+} LogCallsiteState;
+
+/// @brief Static descriptor of a callsite from LOG_CALLSITE_(). It's initialized at compile time, so the source
+///        location is attached to each log event by a pointer without any formatting. Read only, except the state
+///        by set_log_callsites_enabled().
+typedef struct LogCallsite {
+	LogLevel level;
+	const char *location;                                                                                                  // "file.c:123"
+	const char *file;
+	int line;
+	const char *function;
+	const char *format;
+	atomic_int state;
+	struct LogCallsite *next;
+} LogCallsite;
+
 /// @brief Logging container. Offers to write a log event into a given file name.
 ///
 /// If the member on_console_only is set to true,
@@ -90,6 +160,120 @@ typedef enum {
 ///
 /// - nbr_of_keeping_files = The number of files to keep, before the oldest file is going to overwrite.
 ///                          Only in use for DAILY_ROTATION or SIZE_ROTATION. If the value is <2, then the number is set to 2 by default.
+///
+/// - rotation_naming      = optional; the naming of rotated files, only in use for DAILY_ROTATION or SIZE_ROTATION.
+///                          NAMING_SHIFT (default) or NAMING_SEQUENCE, which makes a rotation independent of nbr_of_keeping_files.
+///
+/// - background_housekeeping = optional flag; only in use for DAILY_ROTATION or SIZE_ROTATION. If set, then a rotation on the
+///                          caller's thread only renames the current log file and opens a new one. Renaming and removing
+///                          the rotated files is done by a background thread. dispose() waits, until it's done.
+///
+/// - compress_rotated_files = optional flag; only in use for DAILY_ROTATION or SIZE_ROTATION. If set, then every rotated file
+///                          is compressed to "<name>.gz" by the background thread. Sets background_housekeeping, too.
+///                          Only available, if logging.c has been built with LOG_WITH_ZLIB (and linked with -lz).
+///
+/// - preallocate_files    = optional flag; only in use for SIZE_ROTATION. If set, then each new log file reserves file_size_in_mb
+///                          on the disk at once (Linux: fallocate with FALLOC_FL_KEEP_SIZE, Windows: FileAllocationInfo).
+///                          The unused space is released by a rotation or at the end of the log session. No effect on other systems.
+///
+/// - memory_mapped_files  = optional flag; only in use for SIZE_ROTATION. If set, then the log file is mapped into the memory
+///                          with the size of file_size_in_mb and each log line is copied into it without any lock or system call.
+///                          While logging the rest of the log file is filled with '\0' characters. The log file is cut to its
+///                          real length by a rotation or at the end of the log session. batch_mode and preallocate_files are ignored.
+///
+/// - io_uring_files       = optional flag; only available on Linux. If set, then log lines for a file are collected like batch_mode
+///                          (batch_size_in_kb, flush_interval_in_ms) and each batch is submitted to io_uring, so the caller doesn't
+///                          wait for the write. Implies keep_file_open. If io_uring or its writes (Linux 5.6) aren't available,
+///                          then the log lines are collected like batch_mode and written by the log session. Ignored with
+///                          memory_mapped_files.
+///                          NOTE: Collected and submitted log lines are lost on a crash.
+///
+/// - binary_format        = optional flag; if set, then a log event for a file isn't formatted at all. Only the number of its format
+///                          string, the time, the level and the raw arguments are written into the log file. Each format string is
+///                          written once for each log file. The log file is rendered as text by decode_binary_log() or log_decoder.
+///                          A log event with "%n", wide characters or more than LENGTH_LOG_MESSAGE bytes of arguments is formatted and
+///                          written as text record instead. memory_mapped_files is ignored.
+///
+/// - json_lines           = optional flag; if set, then each log event for a file is written as a single JSON object per line:
+///                          {"time":"2026-10-16 12:34:56","level":"INFO","message":"...","key":"value"}
+///                          The fields come from write_to_log_kv(). Every string is escaped for JSON, other bytes (e.g. UTF-8)
+///                          are copied as they are. No effect for on_console_only. Ignored with binary_format.
+///
+/// - flight_recorder      = optional flag; if set, then log events from flight_recorder_level up to init_level (exclusive) aren't
+///                          written, but kept in a ring buffer of the calling thread in the memory. The oldest log events are
+///                          overwritten. A LOG_ERROR or LOG_FATAL log event of the same thread writes the kept log events before
+///                          itself, so the context of a failure is logged without writing every TRACE or DEBUG log event.
+///                          Ignored with binary_format.
+///                          NOTE: Every thread gets its own ring buffer with its first kept log event. The ring buffers are
+///                                released by dispose() or destroy_logger(), so no thread may log at the same time.
+///
+/// - flight_recorder_level = Only in use for flight_recorder. The lowest level, which is kept. By default LOG_TRACE.
+///
+/// - flight_recorder_size_in_kb = Only in use for flight_recorder. The size of the ring buffer of each thread in KB.
+///                          If the value is <1, then DEFAULT_FLIGHT_RECORDER_SIZE_IN_KB is in use.
+///
+/// - suppress_repeated_messages = optional flag; if set, then a log message, which is the same as the previous one of the
+///                          log session (level, message and fields), is only counted. The next different log message, dispose()
+///                          or the end of repeat_window_in_ms writes "last message repeated N times" instead. Ignored with
+///                          binary_format and memory_mapped_files.
+///
+/// - repeat_window_in_ms  = Only in use for suppress_repeated_messages. The maximal time in ms, repeated log messages are counted.
+///                          Afterwards the summary and the log message are written again. Without async_mode this is checked
+///                          by the next log event or dispose(). If the value is <1, then DEFAULT_REPEAT_WINDOW_IN_MS is in use.
+///
+/// - rate_limits          = optional; the maximal number of log events per second for each level, e.g. rate_limits[LOG_DEBUG] = 1000.
+///                          0 is unlimited (default). Each level has a token bucket for up to one second of log events at once.
+///                          A log event above the limit is dropped before it's formatted and only counted, see: get_suppressed_log_events()
+///                          Log events, which are only kept by the flight recorder, aren't limited.
+///
+/// - suppression_report_interval_in_ms = The time in ms between two reports of the log events, which have been suppressed by
+///                          rate_limits or LOG_SAMPLED_(), e.g. "suppressed 1234 log events by sampling or rate limits: DEBUG 1234".
+///                          The report is written at LOG_WARNING, even above the log level, by the next log event afterwards and
+///                          by dispose(). If the value is <1, then DEFAULT_SUPPRESSION_REPORT_INTERVAL_IN_MS is in use.
+///
+/// - config_file          = optional; a config file, which is read while initializing and reloaded by a background thread,
+///                          whenever it has been changed. It sets the log level and the callsites of LOG_CALLSITE_() without
+///                          a new initializing, see: reload_log_config(). Empty, if not in use.
+///
+/// - config_check_interval_in_ms = Only in use for config_file. The time in ms between two checks of the config file.
+///                          If the value is <1, then DEFAULT_CONFIG_CHECK_INTERVAL_IN_MS is in use.
+///
+/// - reload_on_sighup     = optional flag; only in use for config_file and not available on Windows. If set, then SIGHUP
+///                          reloads the config file within about a second, even if it hasn't been changed. The signal handler
+///                          only sets a flag, the config file is read by the background thread.
+///                          NOTE: The library takes over SIGHUP with sigaction(): the handler of the application is replaced,
+///                          until the last log session with this flag has been disposed, then it's restored.
+///
+/// - keep_file_open       = optional flag; if set, then the log file is opened once while initializing and stays open
+///                          for every following log event. The file is only reopened on a rotation or after dispose().
+///                          If unset, then the log file is opened and closed for each log event.
+///
+/// - async_mode           = optional flag; if set, then every log event for a file is formatted on the caller's thread
+///                          into a queue and a background writer thread writes it into the file. No effect for on_console_only.
+///
+/// - async_queue_size     = Only in use for async_mode. The number of log events, which can wait in the queue.
+///                          If the value is <2, then DEFAULT_ASYNC_QUEUE_SIZE is in use. Rounded up to a power of 2.
+///
+/// - overflow_policy      = Only in use for async_mode. What to do, if the queue is full:
+///                          OVERFLOW_BLOCK       = wait, until the writer thread has made space (default)
+///                          OVERFLOW_DROP_NEWEST = drop the new log event
+///                          OVERFLOW_DROP_OLDEST = drop the oldest log event in the queue
+///                          Every dropped log event is counted, see: get_dropped_log_events()
+///
+/// - timestamp_precision  = optional; the fraction of a second behind the timestamp, e.g. "2026-10-16 12:34:56.789"
+///                          for TIMESTAMP_MILLISECONDS. By default only seconds are in use (TIMESTAMP_SECONDS).
+///
+/// - batch_mode           = optional flag; if set, then complete log lines for a file are collected in a buffer and
+///                          written at once. The buffer is written, if it's full, if flush_interval_in_ms has been passed
+///                          or immediately for LOG_ERROR and LOG_FATAL. No effect for on_console_only.
+///                          NOTE: Collected log lines are lost on a crash.
+///
+/// - batch_size_in_kb     = Only in use for batch_mode. The size of the buffer in KB.
+///                          If the value is <1, then DEFAULT_BATCH_SIZE_IN_KB is in use.
+///
+/// - flush_interval_in_ms = Only in use for batch_mode. The maximal time in ms, a log line is collected. Without async_mode
+///                          a background thread writes the batch afterwards, even if no further log event comes.
+///                          If the value is <1, then DEFAULT_FLUSH_INTERVAL_IN_MS is in use.
 typedef struct {
 	char file_name[LENGTH_FILE_NAME];
 	LogLevel init_level;
@@ -97,8 +281,38 @@ typedef struct {
 	int file_size_in_mb;
 	int nbr_of_keeping_files;
 	bool on_console_only;
+	bool keep_file_open;
+	bool async_mode;
+	int async_queue_size;
+	LogOverflowPolicy overflow_policy;
+	LogTimestampPrecision timestamp_precision;
+	bool batch_mode;
+	int batch_size_in_kb;
+	int flush_interval_in_ms;
+	LogRotationNaming rotation_naming;
+	bool background_housekeeping;
+	bool compress_rotated_files;
+	bool preallocate_files;
+	bool memory_mapped_files;
+	bool io_uring_files;
+	bool binary_format;
+	bool json_lines;
+	bool flight_recorder;
+	LogLevel flight_recorder_level;
+	int flight_recorder_size_in_kb;
+	bool suppress_repeated_messages;
+	int repeat_window_in_ms;
+	int rate_limits[LOG_FATAL + 1];
+	int suppression_report_interval_in_ms;
+	char config_file[FILE_NAME_LOG_ROTATION];
+	int config_check_interval_in_ms;
+	bool reload_on_sighup;
 } Logging;
 
+/// @brief Handle of an independent log session. Every instance owns its own file, level, rotation state
+///        and locks, so different log sessions never wait on each other. See: create_logger()
+typedef struct Logger Logger;
+
 // -----------
 // function prototypes
 // -----------
@@ -119,6 +333,9 @@ void init_log_by_arguments(const char *file_name, const LogLevel init_level, con
 
 /// @brief Log a message into a file. If console output is set, then the log messages are moved to stdout instead.
 ///
+/// NOTE: A log message, which is longer than LENGTH_LOG_MESSAGE, is formatted into a growable buffer of the
+///       calling thread. In async mode such a log message is cut, see: get_truncated_log_events()
+///
 /// NOTE: Depending on the given LOG_LEVEL every log message, which is below the given level, won't be handled.
 ///
 /// NOTE: If a log output to stdout is set, then no output will be written into a file.
@@ -126,11 +343,269 @@ void init_log_by_arguments(const char *file_name, const LogLevel init_level, con
 /// @param format the formatted text
 void write_to_log(LogLevel level, const char* format, ...);
 
+/// @brief Log a message with fields, given as pairs of key and value and terminated by NULL:
+///        write_to_log_kv(LOG_INFO, "user logged in", "user", name, "id", id_text, NULL);
+///
+///        With Logging.json_lines every field becomes a member of the JSON object. Otherwise the fields are
+///        written behind the log message as: key="value"
+///
+/// NOTE: The message isn't a format string. Only MAX_LOG_FIELDS pairs are in use, further pairs are ignored.
+///       A value, which points to NULL, is written as "(null)".
+/// @param level current log level
+/// @param message the log message
+void write_to_log_kv(LogLevel level, const char *message, ...) LOG_SENTINEL;
+
+/// @brief Change the log level at runtime without a new initializing. The log file, the rotation state and every
+///        other setting are kept. The level is published atomically, so logging threads don't wait for any lock.
+/// @param level the new log level; level range: [LOG_TRACE .. LOG_FATAL]
+void set_log_level(LogLevel level);
+
+/// @brief Receive the current log level.
+/// @return the log level
+LogLevel get_log_level(void);
+
+/// @brief Read a config file and apply it at once, see: Logging.config_file. Each line is "key = value",
+///        '#' starts a comment:
+///        level = DEBUG                   the log level
+///        callsite parser.c = WARN        every callsite of LOG_CALLSITE_() in parser.c below LOG_WARNING is disabled
+///        callsite parser.c:42 = off      a single callsite is disabled, "on" enables it again; "*" is every file
+///
+/// NOTE: The rules for callsites are shared by every log session. An invalid line is ignored with a warning.
+/// @param file_name the config file
+/// @return true, if the config file has been read and every line is valid
+bool reload_log_config(const char *file_name);
+
+/// @brief Log a message like write_to_log() and count the calls, which have been skipped before. Used by LOG_SAMPLED_().
+/// @param level current log level
+/// @param skipped number of skipped calls of the same callsite since the previous call
+/// @param format the formatted text
+void write_to_log_sampled(LogLevel level, unsigned int skipped, const char *format, ...);
+
 // /// @brief Determine the current log file for file rotation.
 // /// @param buffer last known log file name
 // /// @param size the length of characters for buffer argument
 // void determine_log_filename(char* buffer, size_t size);
 
-/// @brief Dispose allocated memory for logging.
+/// @brief Receive the number of log events, which have been dropped in async mode because of a full queue.
+///        The counter is reset by each initializing.
+/// @return number of dropped log events
+unsigned long long get_dropped_log_events(void);
+
+/// @brief Log a message of a callsite from LOG_CALLSITE_() like write_to_log() with its source location as fields:
+///        source="file.c:123" function="main"
+///        With Logging.json_lines they become the members "source" and "function" of the JSON object.
+/// @param callsite the static descriptor of the callsite; its level is in use
+/// @param format the formatted text
+void write_to_log_at(const LogCallsite *callsite, const char *format, ...);
+
+/// @brief Register a callsite from LOG_CALLSITE_() by its first handled call. Every rule of set_log_callsites_enabled(),
+///        which matches the callsite, is applied.
+/// @param callsite the static descriptor of the callsite
+/// @return true, if the callsite is enabled
+bool register_log_callsite(LogCallsite *callsite);
+
+/// @brief Enable or disable the callsites of LOG_CALLSITE_() at runtime, e.g. every callsite of "parser.c":
+///        set_log_callsites_enabled("parser.c", 0, false);
+///        The rule is kept for callsites, which are registered afterwards. A later rule wins over an earlier one.
+///
+/// NOTE: Only MAX_LOG_CALLSITE_RULES different rules are kept. A further one only changes the registered callsites.
+/// @param file the end of the source file name of the callsites, e.g. "parser.c" for "src/parser.c"; NULL for every file
+/// @param line the line of the callsite; 0 for every line
+/// @param enabled true to enable, false to disable the callsites
+/// @return number of registered callsites, which match
+int set_log_callsites_enabled(const char *file, int line, bool enabled);
+
+/// @brief Set a threshold for the callsites of LOG_CALLSITE_() of a source file: each callsite below the level is disabled,
+///        every other one is enabled. The rule is kept like a rule of set_log_callsites_enabled().
+/// @param file the end of the source file name of the callsites, e.g. "parser.c" for "src/parser.c"; NULL for every file
+/// @param level the lowest level of an enabled callsite
+/// @return number of registered callsites, which match
+int set_log_callsites_level(const char *file, LogLevel level);
+
+/// @brief Call a function for each registered callsite of LOG_CALLSITE_(), e.g. to list them. The function must not
+///        log by LOG_CALLSITE_() or change a callsite.
+/// @param visit the function, which receives each callsite and the context
+/// @param context any argument for visit
+void visit_log_callsites(void (*visit)(const LogCallsite *callsite, void *context), void *context);
+
+/// @brief Receive the number of log messages, which have been cut at LENGTH_LOG_MESSAGE characters.
+///        A longer log message is only cut in async mode or if no memory is left.
+///        The counter is reset by each initializing.
+/// @return number of truncated log messages
+unsigned long long get_truncated_log_events(void);
+
+/// @brief Receive the number of log events, which have been suppressed by Logging.rate_limits or LOG_SAMPLED_().
+///        The counter is reset by each initializing.
+/// @return number of suppressed log events
+unsigned long long get_suppressed_log_events(void);
+
+/// @brief Dispose allocated memory for logging. If the log file is kept open, then the file is closed here
+///        and is going to reopen with the next log event. The buffer for long log messages of the calling
+///        thread is released.
+///
+///        In batch mode the collected log lines are written and the buffer is released. Following log lines
+///        are written one by one.
+///
+///        In async mode every queued log event is written before the background writer thread stops.
+///        Following log events are written on the caller's thread.
 void dispose(void);
+
+/// @brief Create a new, independent log session by given Logging container. The settings are checked like in init_log().
+///        If the argument is NULL, then a default setting with console output and init_level to LOG_INFO is in use instead.
+///
+/// NOTE: Two log sessions shall not write into the same log file.
+/// @param log the logging container with known settings
+/// @return the new log session or NULL, if no memory is left
+Logger *create_logger(const Logging *log);
+
+/// @brief Log a message into the log session from create_logger(). Works like write_to_log().
+/// @param logger log session to use
+/// @param level current log level
+/// @param format the formatted text
+void write_to_logger(Logger *logger, LogLevel level, const char *format, ...);
+
+/// @brief Log a message with fields into the log session from create_logger(). Works like write_to_log_kv().
+/// @param logger log session to use
+/// @param level current log level
+/// @param message the log message
+void write_to_logger_kv(Logger *logger, LogLevel level, const char *message, ...) LOG_SENTINEL;
+
+/// @brief Like set_log_level(), but for a log session from create_logger().
+/// @param logger log session to use
+/// @param level the new log level; level range: [LOG_TRACE .. LOG_FATAL]
+void set_logger_level(Logger *logger, LogLevel level);
+
+/// @brief Like get_dropped_log_events(), but for a log session from create_logger().
+/// @param logger log session to use
+/// @return number of dropped log events
+unsigned long long get_logger_dropped_log_events(const Logger *logger);
+
+/// @brief Like get_truncated_log_events(), but for a log session from create_logger().
+/// @param logger log session to use
+/// @return number of truncated log messages
+unsigned long long get_logger_truncated_log_events(const Logger *logger);
+
+/// @brief Like get_suppressed_log_events(), but for a log session from create_logger().
+/// @param logger log session to use
+/// @return number of suppressed log events
+unsigned long long get_logger_suppressed_log_events(const Logger *logger);
+
+/// @brief Close the log session from create_logger() and release its memory. Every queued log event in async mode
+///        is written before. The handle must not be used anymore afterwards. NULL is ignored.
+/// @param logger log session to destroy
+void destroy_logger(Logger *logger);
+
+/// @brief Render a binary log file from Logging.binary_format as text: "[timestamp] [LEVEL] message" for each log event.
+///        The binary log file must have been written on the same platform. See: log_decoder.c
+/// @param file_name the binary log file
+/// @param output destination of the log lines, e.g. stdout
+/// @return true, if every log event has been decoded, otherwise false
+bool decode_binary_log(const char *file_name, FILE *output);
+
+// -----------
+// macros
+// -----------
+
+/// @brief Implementation detail of the macros, don't use it. A read only view of the lowest handled log level of the
+///        default log session: the current log level or the level of Logging.flight_recorder.
+///        Use get_log_level() and set_log_level() instead.
+extern const atomic_int *const log_internal_handled_level;
+
+/// @brief Implementation detail of LOG_LEVEL_ENABLED(). Returns the lowest handled log level of the default log session.
+static inline int log_internal_lowest_level(void) {
+	return atomic_load_explicit(log_internal_handled_level, memory_order_relaxed);
+}
+
+/// @brief Check at runtime, if a log event with the given level is going to be handled.
+#define LOG_LEVEL_ENABLED(level) \
+	((int)(level) >= log_internal_lowest_level())
+
+/// @brief Log a message like write_to_log(), but the arguments are only evaluated and write_to_log() is only called,
+///        if the level is handled. A constant level below LOG_MIN_LEVEL compiles to nothing.
+#define LOG_AT_LEVEL_(level, ...) \
+	do { \
+		if ((int)(level) >= LOG_MIN_LEVEL && LOG_LEVEL_ENABLED(level)) { \
+			write_to_log((level), __VA_ARGS__); \
+		} \
+	} while (0)
+
+/// @brief Log a message like LOG_AT_LEVEL_(), but only the first of every n calls of this callsite, e.g. in a hot loop:
+///        LOG_SAMPLED_(LOG_DEBUG, 100, "item %d processed", i);
+///        Each callsite has its own counter. every is evaluated once for each handled call, the arguments of a skipped
+///        call aren't evaluated. The skipped calls are counted as suppressed log events, when the next call of the
+///        callsite is logged, see: get_suppressed_log_events()
+///        A constant level below LOG_MIN_LEVEL compiles to nothing.
+#define LOG_SAMPLED_(level, every, ...) \
+	do { \
+		static atomic_uint _log_sampling_calls; \
+		if ((int)(level) >= LOG_MIN_LEVEL && LOG_LEVEL_ENABLED(level)) { \
+			unsigned int _log_sampling_every = (unsigned int)(every); \
+			unsigned int _log_sampling_call = atomic_fetch_add_explicit(&_log_sampling_calls, 1, memory_order_relaxed); \
+			if (_log_sampling_every <= 1 || _log_sampling_call % _log_sampling_every == 0) { \
+				write_to_log_sampled((level), _log_sampling_call == 0 || _log_sampling_every <= 1 ? 0 : _log_sampling_every - 1, __VA_ARGS__); \
+			} \
+		} \
+	} while (0)
+
+// helpers for LOG_CALLSITE_(): the line as string literal and the format string of the arguments
+#define LOG_STRINGIFY_(value)      LOG_STRINGIFY_VALUE_(value)
+#define LOG_STRINGIFY_VALUE_(value) #value
+#define LOG_FORMAT_OF_(format, ...) format
+
+/// @brief Check, if a callsite of LOG_CALLSITE_() is enabled. The first check registers the callsite.
+#define LOG_CALLSITE_ENABLED(callsite) \
+	(atomic_load_explicit(&(callsite)->state, memory_order_relaxed) == CALLSITE_ENABLED || \
+	 (atomic_load_explicit(&(callsite)->state, memory_order_acquire) == CALLSITE_UNREGISTERED && register_log_callsite(callsite)))
+
+/// @brief Log a message like LOG_AT_LEVEL_() together with its source location, e.g.
+///        LOG_CALLSITE_(LOG_DEBUG, "cache miss for %s", key);
+///        The level, file, line, function and format string are kept in a static descriptor of this callsite, which is
+///        registered by its first handled call. Each callsite can be disabled at runtime, see: set_log_callsites_enabled()
+///        The level and the format string must be constants. A level below LOG_MIN_LEVEL compiles to nothing.
+#define LOG_CALLSITE_(callsite_level, ...) \
+	do { \
+		static LogCallsite _log_callsite = { \
+			.level = (callsite_level), .location = __FILE__ ":" LOG_STRINGIFY_(__LINE__), .file = __FILE__, .line = __LINE__, \
+			.function = __func__, .format = LOG_FORMAT_OF_(__VA_ARGS__, 0) \
+		}; \
+		if ((int)(callsite_level) >= LOG_MIN_LEVEL && LOG_LEVEL_ENABLED(callsite_level) && LOG_CALLSITE_ENABLED(&_log_callsite)) { \
+			write_to_log_at(&_log_callsite, __VA_ARGS__); \
+		} \
+	} while (0)
+
+#if LOG_MIN_LEVEL <= 0
+#define LOG_TRACE_(...)   LOG_AT_LEVEL_(LOG_TRACE, __VA_ARGS__)
+#else
+#define LOG_TRACE_(...)   ((void)0)
+#endif
+
+#if LOG_MIN_LEVEL <= 1
+#define LOG_DEBUG_(...)   LOG_AT_LEVEL_(LOG_DEBUG, __VA_ARGS__)
+#else
+#define LOG_DEBUG_(...)   ((void)0)
+#endif
+
+#if LOG_MIN_LEVEL <= 2
+#define LOG_INFO_(...)    LOG_AT_LEVEL_(LOG_INFO, __VA_ARGS__)
+#else
+#define LOG_INFO_(...)    ((void)0)
+#endif
+
+#if LOG_MIN_LEVEL <= 3
+#define LOG_WARNING_(...) LOG_AT_LEVEL_(LOG_WARNING, __VA_ARGS__)
+#else
+#define LOG_WARNING_(...) ((void)0)
+#endif
+
+#if LOG_MIN_LEVEL <= 4
+#define LOG_ERROR_(...)   LOG_AT_LEVEL_(LOG_ERROR, __VA_ARGS__)
+#else
+#define LOG_ERROR_(...)   ((void)0)
+#endif
+
+#if LOG_MIN_LEVEL <= 5
+#define LOG_FATAL_(...)   LOG_AT_LEVEL_(LOG_FATAL, __VA_ARGS__)
+#else
+#define LOG_FATAL_(...)   ((void)0)
+#endif
 #endif
\ No newline at end of file
@@ -0,0 +1,23 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include "logging.h"
+
+int main(int argc, char **argv) {
+	if (argc < 2 || strcmp(argv[1], "-h") == 0) {
+		printf("usage: %s <binary log file> [<binary log file> ...]\n", argv[0]);
+		printf("renders binary log files from Logging.binary_format as text on stdout\n");
+		return argc < 2 ? EXIT_FAILURE : EXIT_SUCCESS;
+	}
+
+	// NOTE: The binary log files must have been written on the same platform (byte order, size of long double).
+	//       Rotated files are decoded on their own, so pass them from the oldest to the newest.
+	bool valid = true;
+
+	for (int i = 1; i < argc; i++) {
+		valid = decode_binary_log(argv[i], stdout) && valid;
+	}
+
+	return valid ? EXIT_SUCCESS : EXIT_FAILURE;
+}
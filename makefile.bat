@@ -6,12 +6,16 @@
 setlocal
 
 set DESTINATION=log_writer.exe
+set BENCH_DESTINATION=log_benchmark.exe
+set DECODER_DESTINATION=log_decoder.exe
 set LIB_PATH=lib/logging.c
 
 ::	some checks before...
 if "%1" == "" goto help_function
 if not "%2" == "" goto help_function
 if "%1" == "build" goto build_app
+if "%1" == "bench" goto bench_app
+if "%1" == "decoder" goto decoder_app
 if "%1" == "clean" goto clean_up
 
 ::	for any other single argument
@@ -21,8 +25,10 @@ goto help_function
 ::	functions
 ::	--------------
 :help_function
-echo "usage: makefile.bat [build | clean]"
+echo "usage: makefile.bat [build | bench | decoder | clean]"
 echo build = build the application
+echo bench = build and run the benchmark
+echo decoder = build the decoder for binary log files
 echo clean = removes the application
 goto :eof
 
@@ -31,8 +37,20 @@ gcc.exe -g3 -Wall -Ilib %LIB_PATH% main.c -o %DESTINATION%
 echo application built
 goto :eof
 
+:bench_app
+gcc.exe -O2 -Wall -Ilib %LIB_PATH% tests/benchmark.c -o %BENCH_DESTINATION%
+%BENCH_DESTINATION%
+goto :eof
+
+:decoder_app
+gcc.exe -g3 -Wall -Ilib %LIB_PATH% log_decoder.c -o %DECODER_DESTINATION%
+echo decoder built
+goto :eof
+
 :clean_up
 del %DESTINATION% 2>&1>nul
+del %BENCH_DESTINATION% 2>&1>nul
+del %DECODER_DESTINATION% 2>&1>nul
 echo application removed, if existing
 goto :eof
 
@@ -0,0 +1,310 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "logging.h"
+
+#ifdef _WIN32
+#include <Windows.h>
+#include <io.h>
+#define dup _dup
+#define dup2 _dup2
+#define fileno _fileno
+#define close _close
+#define NULL_DEVICE "NUL"
+#else
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#define NULL_DEVICE "/dev/null"
+#endif
+
+#define LOG_MESSAGE      "This is a simple message with a number: %d"
+#define BENCH_FILE       "bench.log"
+#define DEFAULT_LINES    200000
+#define MAX_THREADS      8
+
+/// @brief Settings and results of a single benchmark thread.
+typedef struct {
+	LogLevel level;
+	bool use_macros;
+	int lines;
+	uint64_t *latencies;
+} BenchThread;
+
+/// @brief Monotonic clock in nanoseconds.
+static uint64_t _now_in_ns(void) {
+	#ifdef _WIN32
+	static LARGE_INTEGER frequency;
+	LARGE_INTEGER counter;
+
+	if (frequency.QuadPart == 0) {
+		QueryPerformanceFrequency(&frequency);
+	}
+
+	QueryPerformanceCounter(&counter);
+	return (uint64_t)((double)counter.QuadPart * 1e9 / (double)frequency.QuadPart);
+	#else
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+	#endif
+}
+
+/// @brief Write the log events of one thread and measure the latency of each call.
+#ifdef _WIN32
+static DWORD WINAPI _bench_thread(LPVOID argument) {
+#else
+static void *_bench_thread(void *argument) {
+#endif
+	BenchThread *bench = (BenchThread *)argument;
+
+	for (int i = 0; i < bench->lines; i++) {
+		uint64_t start = _now_in_ns();
+
+		if (bench->use_macros) {
+			LOG_AT_LEVEL_(bench->level, LOG_MESSAGE, i);
+		} else {
+			write_to_log(bench->level, LOG_MESSAGE, i);
+		}
+
+		bench->latencies[i] = _now_in_ns() - start;
+	}
+
+	return 0;
+}
+
+static int _compare_latencies(const void *a, const void *b) {
+	uint64_t left = *(const uint64_t *)a;
+	uint64_t right = *(const uint64_t *)b;
+	return (left > right) - (left < right);
+}
+
+/// @brief Remove the benchmark log file and its rotated files.
+static void _remove_bench_files(void) {
+	char name[64];
+	remove(BENCH_FILE);
+
+	for (int i = 1; i <= 16; i++) {
+		snprintf(name, sizeof(name), "%s.%d", BENCH_FILE, i);
+		remove(name);
+	}
+}
+
+/// @brief Run a single benchmark scenario and print one result line.
+/// @param description name of the scenario
+/// @param log settings for the log session
+/// @param level level of each log event
+/// @param use_macros true, if the LOG_*_() macros are in use instead of write_to_log()
+/// @param nbr_of_threads number of threads, which are writing at the same time
+/// @param lines number of log events per thread
+static void _run_scenario(const char *description, Logging *log, LogLevel level, bool use_macros, int nbr_of_threads, int lines) {
+	size_t total_lines = (size_t)nbr_of_threads * (size_t)lines;
+	uint64_t *latencies = malloc(total_lines * sizeof(uint64_t));
+	BenchThread benches[MAX_THREADS];
+
+	if (latencies == NULL) {
+		fprintf(stderr, "%s: not enough memory\n", description);
+		return;
+	}
+
+	// console output is thrown away, but still written
+	int saved_stdout = -1;
+
+	if (log->on_console_only) {
+		fflush(stdout);
+		saved_stdout = dup(fileno(stdout));
+		freopen(NULL_DEVICE, "w", stdout);
+	}
+
+	_remove_bench_files();
+	init_log(log);
+
+	uint64_t start = _now_in_ns();
+
+	for (int i = 0; i < nbr_of_threads; i++) {
+		benches[i].level = level;
+		benches[i].use_macros = use_macros;
+		benches[i].lines = lines;
+		benches[i].latencies = latencies + (size_t)i * (size_t)lines;
+	}
+
+	if (nbr_of_threads == 1) {
+		_bench_thread(&benches[0]);
+	} else {
+		#ifdef _WIN32
+		HANDLE threads[MAX_THREADS];
+
+		for (int i = 0; i < nbr_of_threads; i++) {
+			threads[i] = CreateThread(NULL, 0, _bench_thread, &benches[i], 0, NULL);
+		}
+
+		WaitForMultipleObjects(nbr_of_threads, threads, TRUE, INFINITE);
+
+		for (int i = 0; i < nbr_of_threads; i++) {
+			CloseHandle(threads[i]);
+		}
+		#else
+		pthread_t threads[MAX_THREADS];
+
+		for (int i = 0; i < nbr_of_threads; i++) {
+			pthread_create(&threads[i], NULL, _bench_thread, &benches[i]);
+		}
+
+		for (int i = 0; i < nbr_of_threads; i++) {
+			pthread_join(threads[i], NULL);
+		}
+		#endif
+	}
+
+	// the time to write everything out belongs to the benchmark, too
+	dispose();
+	uint64_t elapsed = _now_in_ns() - start;
+
+	if (saved_stdout >= 0) {
+		fflush(stdout);
+		dup2(saved_stdout, fileno(stdout));
+		close(saved_stdout);
+	}
+
+	qsort(latencies, total_lines, sizeof(uint64_t), _compare_latencies);
+
+	printf(
+		"%-34s %8zu %10.1f %12.0f %8llu %8llu %8llu\n",
+		description, total_lines,
+		(double)elapsed / (double)total_lines,
+		(double)total_lines * 1e9 / (double)elapsed,
+		(unsigned long long)latencies[total_lines / 2],
+		(unsigned long long)latencies[total_lines * 99 / 100],
+		(unsigned long long)latencies[total_lines * 999 / 1000]
+	);
+
+	free(latencies);
+	_remove_bench_files();
+}
+
+int main(int argc, char **argv) {
+	// usage: benchmark [lines per scenario] [max number of threads]
+	int lines = argc > 1 ? atoi(argv[1]) : DEFAULT_LINES;
+	int max_threads = argc > 2 ? atoi(argv[2]) : 4;
+
+	if (lines < 1000) {
+		lines = 1000;
+	}
+
+	if (max_threads < 1 || max_threads > MAX_THREADS) {
+		max_threads = MAX_THREADS;
+	}
+
+	printf(
+		"%-34s %8s %10s %12s %8s %8s %8s\n",
+		"scenario", "lines", "ns/line", "lines/s", "p50 ns", "p99 ns", "p999 ns"
+	);
+
+	Logging console = {.on_console_only = true, .init_level = LOG_INFO};
+	_run_scenario("console", &console, LOG_INFO, false, 1, lines);
+
+	Logging file = {
+		.file_name = BENCH_FILE,
+		.init_level = LOG_INFO,
+		.rotation_setting = NO_ROTATION
+	};
+
+	_run_scenario("filtered level (LOG_DEBUG)", &file, LOG_DEBUG, false, 1, lines);
+	_run_scenario("filtered level (LOG_DEBUG_ macro)", &file, LOG_DEBUG, true, 1, lines);
+
+	// kept in the memory only, nothing is written without an error
+	file.flight_recorder = true;
+	_run_scenario("flight recorder (LOG_DEBUG)", &file, LOG_DEBUG, false, 1, lines);
+	file.flight_recorder = false;
+
+	_run_scenario("NO_ROTATION open/close", &file, LOG_INFO, false, 1, lines / 10);
+
+	file.keep_file_open = true;
+	_run_scenario("NO_ROTATION", &file, LOG_INFO, false, 1, lines);
+
+	// almost every log event is dropped before it's formatted
+	file.rate_limits[LOG_INFO] = 1000;
+	_run_scenario("NO_ROTATION rate limited (1000/s)", &file, LOG_INFO, false, 1, lines);
+	file.rate_limits[LOG_INFO] = 0;
+
+	file.rotation_setting = DAILY_ROTATION;
+	file.nbr_of_keeping_files = 3;
+	_run_scenario("DAILY_ROTATION", &file, LOG_INFO, false, 1, lines);
+
+	file.rotation_setting = SIZE_ROTATION;
+	file.file_size_in_mb = 1;
+	_run_scenario("SIZE_ROTATION (1 MB)", &file, LOG_INFO, false, 1, lines);
+
+	file.preallocate_files = true;
+	_run_scenario("SIZE_ROTATION (1 MB) preallocated", &file, LOG_INFO, false, 1, lines);
+	file.preallocate_files = false;
+
+	file.memory_mapped_files = true;
+	_run_scenario("SIZE_ROTATION (1 MB) memory mapped", &file, LOG_INFO, false, 1, lines);
+	file.memory_mapped_files = false;
+
+	file.rotation_setting = NO_ROTATION;
+	file.batch_mode = true;
+	_run_scenario("NO_ROTATION batch mode", &file, LOG_INFO, false, 1, lines);
+
+	file.keep_file_open = false;
+	_run_scenario("NO_ROTATION open/close batch mode", &file, LOG_INFO, false, 1, lines);
+
+	file.keep_file_open = true;
+	file.batch_mode = false;
+
+	// the same batches, but submitted to io_uring instead of a blocking write
+	file.io_uring_files = true;
+	_run_scenario("NO_ROTATION io_uring", &file, LOG_INFO, false, 1, lines);
+
+	file.rotation_setting = SIZE_ROTATION;
+	_run_scenario("SIZE_ROTATION (1 MB) io_uring", &file, LOG_INFO, false, 1, lines);
+
+	file.rotation_setting = NO_ROTATION;
+	file.io_uring_files = false;
+
+	// only the raw arguments are written, see: log_decoder.c
+	file.binary_format = true;
+	_run_scenario("NO_ROTATION binary format", &file, LOG_INFO, false, 1, lines);
+
+	file.rotation_setting = SIZE_ROTATION;
+	_run_scenario("SIZE_ROTATION (1 MB) binary format", &file, LOG_INFO, false, 1, lines);
+
+	file.rotation_setting = NO_ROTATION;
+	file.binary_format = false;
+
+	// the same log lines as JSON objects
+	file.json_lines = true;
+	_run_scenario("NO_ROTATION JSON lines", &file, LOG_INFO, false, 1, lines);
+	file.json_lines = false;
+
+	for (int threads = 1; threads <= max_threads; threads *= 2) {
+		char description[64];
+		snprintf(description, sizeof(description), "NO_ROTATION %d thread(s)", threads);
+		_run_scenario(description, &file, LOG_INFO, false, threads, lines / threads);
+	}
+
+	file.rotation_setting = SIZE_ROTATION;
+	file.memory_mapped_files = true;
+
+	for (int threads = 1; threads <= max_threads; threads *= 2) {
+		char description[64];
+		snprintf(description, sizeof(description), "memory mapped %d thread(s)", threads);
+		_run_scenario(description, &file, LOG_INFO, false, threads, lines / threads);
+	}
+
+	file.rotation_setting = NO_ROTATION;
+	file.memory_mapped_files = false;
+	file.async_mode = true;
+	file.overflow_policy = OVERFLOW_BLOCK;
+
+	for (int threads = 1; threads <= max_threads; threads *= 2) {
+		char description[64];
+		snprintf(description, sizeof(description), "async %d thread(s)", threads);
+		_run_scenario(description, &file, LOG_INFO, false, threads, lines / threads);
+	}
+
+	return EXIT_SUCCESS;
+}
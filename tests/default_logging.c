@@ -74,5 +74,43 @@ int main(void) {
 
 	dispose();
 
+	/////
+	///// using a fraction of a second for each timestamp
+	/////
+	for(LogTimestampPrecision precision = TIMESTAMP_SECONDS; precision <= TIMESTAMP_NANOSECONDS; precision++) {
+		Logging precise_log = {
+			.on_console_only = true,
+			.init_level = LOG_TRACE,
+			.timestamp_precision = precision
+		};
+
+		init_log(&precise_log);
+		puts("\n------------");
+
+		for(LogLevel level = LOG_TRACE; level <= LOG_FATAL; level++) {
+			write_to_log(level, LOG_MESSAGE);
+		}
+
+		dispose();
+	}
+
+	/////
+	///// using the macros instead of write_to_log()
+	/////
+	// NOTE: The arguments of a macro are only evaluated, if the level is handled.
+	//       Build with -DLOG_MIN_LEVEL=2 and the macros for TRACE and DEBUG compile to nothing.
+	init_log(NULL);
+	puts("\n------------");
+
+	int counter = 0;
+	LOG_TRACE_("%s (%d)", LOG_MESSAGE, ++counter);          // ignored, counter stays unchanged
+	LOG_DEBUG_("%s (%d)", LOG_MESSAGE, ++counter);          // ignored, counter stays unchanged
+	LOG_INFO_("%s (%d)", LOG_MESSAGE, ++counter);
+	LOG_WARNING_("%s (%d)", LOG_MESSAGE, ++counter);
+	LOG_ERROR_("%s (%d)", LOG_MESSAGE, ++counter);
+	LOG_FATAL_("%s (%d)", LOG_MESSAGE, ++counter);
+
+	dispose();
+
 	return EXIT_SUCCESS;
 }
\ No newline at end of file
@@ -0,0 +1,70 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include "logging.h"
+
+#define LOG_MESSAGE "This is a simple message."
+
+/// @brief Returns the current wall clock time in seconds.
+static double _now_in_seconds(void) {
+	struct timespec ts;
+	timespec_get(&ts, TIME_UTC);
+	return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+/// @brief Write 1,000,000 log events in async mode and print, how long the caller was busy.
+static void _run_async_logging(Logging *log, const char *description) {
+	init_log(log);
+
+	double start = _now_in_seconds();
+
+	for(int i = 0; i < 1000000; i++) {
+		write_to_log(LOG_INFO, "%s (%d)", LOG_MESSAGE, i);
+	}
+
+	double caller_time = _now_in_seconds() - start;
+
+	// waits, until every queued log event has been written
+	dispose();
+
+	double total_time = _now_in_seconds() - start;
+	printf(
+		"%-22s caller: %6.3f s  total: %6.3f s  dropped: %llu\n",
+		description, caller_time, total_time, get_dropped_log_events()
+	);
+}
+
+int main(void) {
+	// Create a new log construction.
+	// NOTE: In async mode the caller only formats the log event into a queue.
+	//       A background writer thread writes it into the file.
+	//       If the queue is full, then the overflow_policy decides,
+	//       if the caller waits or a log event is dropped.
+	Logging log = {
+		.on_console_only = false,
+		.init_level = LOG_INFO,
+		.file_name = "output.log",
+		.rotation_setting = SIZE_ROTATION,
+		.nbr_of_keeping_files = 5,
+		.file_size_in_mb = 10,
+		.keep_file_open = true,
+		.async_mode = true,
+		.async_queue_size = 4096
+	};
+
+	// no log event is lost, the caller waits for free space
+	log.overflow_policy = OVERFLOW_BLOCK;
+	_run_async_logging(&log, "OVERFLOW_BLOCK:");
+
+	// the caller never waits, new log events are dropped instead
+	log.overflow_policy = OVERFLOW_DROP_NEWEST;
+	_run_async_logging(&log, "OVERFLOW_DROP_NEWEST:");
+
+	// the caller never waits, the oldest queued log events are dropped instead
+	log.overflow_policy = OVERFLOW_DROP_OLDEST;
+	_run_async_logging(&log, "OVERFLOW_DROP_OLDEST:");
+
+	return EXIT_SUCCESS;
+}
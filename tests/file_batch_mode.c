@@ -0,0 +1,139 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include "logging.h"
+
+#define LOG_FILE          "batch_mode.log"
+#define SECOND_LOG_FILE   "batch_mode_second.log"
+#define FLUSH_INTERVAL    50
+#define BURST_LINES       100
+
+/// @brief Returns the current wall clock time in seconds.
+static double _now_in_seconds(void) {
+	struct timespec ts;
+	timespec_get(&ts, TIME_UTC);
+	return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+/// @brief Count the lines of a log file.
+static int _count_log_lines(const char *file_name) {
+	FILE *file = fopen(file_name, "r");
+	char buffer[512];
+	int count = 0;
+
+	while (file != NULL && fgets(buffer, sizeof(buffer), file) != NULL) {
+		count++;
+	}
+
+	if (file != NULL) {
+		fclose(file);
+	}
+
+	return count;
+}
+
+/// @brief Wait up to the given time, until the log file has the expected number of lines.
+/// @return the time in ms until then or -1
+static int _wait_for_lines(const char *file_name, int expected, int timeout_in_ms) {
+	double start = _now_in_seconds();
+
+	while (_count_log_lines(file_name) != expected) {
+		if (_now_in_seconds() - start >= timeout_in_ms / 1000.0) {
+			return -1;
+		}
+	}
+
+	return (int)((_now_in_seconds() - start) * 1000);
+}
+
+/// @brief A burst of log lines is kept in the batch, until the flush interval has been passed. Afterwards the
+///        background thread writes it, even though no further log event comes.
+static bool _check_idle_flush(Logging *log, const char *description) {
+	remove(LOG_FILE);
+	init_log(log);
+
+	for (int i = 0; i < BURST_LINES; i++) {
+		write_to_log(LOG_INFO, "burst line %d", i);
+	}
+
+	int kept = _count_log_lines(LOG_FILE);
+	int flushed_in_ms = _wait_for_lines(LOG_FILE, BURST_LINES, FLUSH_INTERVAL * 20);
+
+	// the next burst waits for its own interval
+	write_to_log(LOG_INFO, "late line");
+	int late_flushed_in_ms = _wait_for_lines(LOG_FILE, BURST_LINES + 1, FLUSH_INTERVAL * 20);
+	dispose();
+
+	bool valid = kept < BURST_LINES && flushed_in_ms >= 0 && late_flushed_in_ms >= 0 && _count_log_lines(LOG_FILE) == BURST_LINES + 1;
+	printf(
+		"%-22s written after %d ms and %d ms: %s\n",
+		description, flushed_in_ms, late_flushed_in_ms, valid ? "passed" : "FAILED"
+	);
+
+	return valid;
+}
+
+/// @brief Two log sessions from create_logger() have their own batch timers.
+static bool _check_two_loggers(Logging *log) {
+	Logging second = *log;
+	snprintf(second.file_name, sizeof(second.file_name), "%s", SECOND_LOG_FILE);
+	second.flush_interval_in_ms = FLUSH_INTERVAL * 2;
+
+	remove(LOG_FILE);
+	remove(SECOND_LOG_FILE);
+	Logger *first_logger = create_logger(log);
+	Logger *second_logger = create_logger(&second);
+
+	for (int i = 0; i < BURST_LINES; i++) {
+		write_to_logger(first_logger, LOG_INFO, "first line %d", i);
+		write_to_logger(second_logger, LOG_INFO, "second line %d", i);
+	}
+
+	int first_in_ms = _wait_for_lines(LOG_FILE, BURST_LINES, FLUSH_INTERVAL * 20);
+	int second_in_ms = _wait_for_lines(SECOND_LOG_FILE, BURST_LINES, FLUSH_INTERVAL * 20);
+
+	// a destroyed log session isn't flushed by the background thread anymore
+	destroy_logger(first_logger);
+	write_to_logger(second_logger, LOG_INFO, "second line %d", BURST_LINES);
+	int late_in_ms = _wait_for_lines(SECOND_LOG_FILE, BURST_LINES + 1, FLUSH_INTERVAL * 20);
+	destroy_logger(second_logger);
+
+	bool valid = first_logger != NULL && second_logger != NULL && first_in_ms >= 0 && second_in_ms >= 0 && late_in_ms >= 0;
+	printf("%-22s %s\n", "two log sessions:", valid ? "passed" : "FAILED");
+
+	remove(SECOND_LOG_FILE);
+	return valid;
+}
+
+int main(void) {
+	// Create a new log construction.
+	// NOTE: With batch_mode the log lines are collected and written at once. Without async_mode a background thread
+	//       writes the batch, when flush_interval_in_ms has been passed, so a burst of log lines isn't kept in memory
+	//       until the next log event comes.
+	Logging log = {
+		.on_console_only = false,
+		.init_level = LOG_INFO,
+		.file_name = LOG_FILE,
+		.rotation_setting = NO_ROTATION,
+		.keep_file_open = true,
+		.batch_mode = true,
+		.flush_interval_in_ms = FLUSH_INTERVAL
+	};
+
+	bool valid = _check_idle_flush(&log, "keep file open:");
+
+	log.keep_file_open = false;
+	valid = _check_idle_flush(&log, "open/close:") && valid;
+
+	log.keep_file_open = true;
+	log.async_mode = true;
+	valid = _check_idle_flush(&log, "async mode:") && valid;
+
+	log.async_mode = false;
+	valid = _check_two_loggers(&log) && valid;
+
+	remove(LOG_FILE);
+	return valid ? EXIT_SUCCESS : EXIT_FAILURE;
+}
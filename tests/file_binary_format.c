@@ -0,0 +1,292 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <time.h>
+#include <wchar.h>
+#include "logging.h"
+
+#define LOG_FILE          "binary.log"
+#define DECODED_FILE      "binary.txt"
+#define KEEPING_FILES     20
+#define NBR_OF_EXPECTED   16
+#define LINES_FOR_SPEED   200000
+
+/// @brief Every log message, which is expected from the decoder, formatted by snprintf() with the same arguments.
+static char _expected[NBR_OF_EXPECTED][LENGTH_LOG_MESSAGE];
+static int _nbr_of_expected = 0;
+
+/// @brief Keep the log message, which is expected from the decoder. A log message, which is formatted as text
+///        record, is cut at LENGTH_LOG_MESSAGE like in async mode.
+static void _expect(const char *format, ...) {
+	va_list args;
+	va_start(args, format);
+	vsnprintf(_expected[_nbr_of_expected++], LENGTH_LOG_MESSAGE, format, args);
+	va_end(args);
+}
+
+/// @brief Write a log event and keep the log message, which is expected from the decoder.
+#define LOG_AND_EXPECT(...) do { \
+		write_to_log(LOG_INFO, __VA_ARGS__); \
+		_expect(__VA_ARGS__); \
+	} while (0)
+
+/// @brief Returns the current wall clock time in seconds.
+static double _now_in_seconds(void) {
+	struct timespec ts;
+	timespec_get(&ts, TIME_UTC);
+	return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+/// @brief Remove the log file, every rotated file and the decoded file.
+static void _remove_log_files(void) {
+	char name[64];
+	remove(LOG_FILE);
+	remove(DECODED_FILE);
+
+	for (int i = 0; i <= KEEPING_FILES; i++) {
+		snprintf(name, sizeof(name), "%s.%d", LOG_FILE, i);
+		remove(name);
+	}
+}
+
+/// @brief Decode a binary log file into DECODED_FILE and open it for reading.
+/// @return the decoded file or NULL, if the binary log file is damaged
+static FILE *_decode(const char *file_name) {
+	FILE *output = fopen(DECODED_FILE, "w");
+
+	if (output == NULL) {
+		return NULL;
+	}
+
+	bool valid = decode_binary_log(file_name, output);
+	fclose(output);
+	return valid ? fopen(DECODED_FILE, "r") : NULL;
+}
+
+/// @brief Each conversion is recorded by its raw argument and must be rendered like printf() does.
+static bool _check_conversions(Logging *log) {
+	_remove_log_files();
+	init_log(log);
+
+	const char *text = "abcdefghij";
+	int value = 42;
+	char reused[64];
+
+	LOG_AND_EXPECT("int %d, negative %i, unsigned %u, hex %#x, char %c, percent %%", 7, -12, 3000000000u, 255, 'z');
+	LOG_AND_EXPECT("double %5.2f | %e | %g | long double %Lf", 3.14159, -0.000123, 1e10, (long double)2.5);
+	LOG_AND_EXPECT("string %s, %.3s, [%-12s], %.*s, [%*d]", text, text, text, 4, text, 6, value);
+	LOG_AND_EXPECT("%lld %llu %zu %ld %hd %hhu %jd %td", -5LL, 18446744073709551615ULL, (size_t)99, -7L, (short)-3, (unsigned char)200, (intmax_t)-9, (ptrdiff_t)-11);
+	LOG_AND_EXPECT("pointer %p", (void *)&value);
+	LOG_AND_EXPECT("no conversion at all");
+
+	// a reused buffer as format string gets a number for each content
+	strcpy(reused, "first content %d");
+	LOG_AND_EXPECT(reused, 1);
+	strcpy(reused, "second content %d");
+	LOG_AND_EXPECT(reused, 2);
+
+	// wide characters aren't recorded, the log message is formatted and written as text
+	LOG_AND_EXPECT("wide %ls", L"characters");
+
+	// the arguments don't fit into a record, the log message is formatted and cut
+	char long_text[2000];
+	memset(long_text, 'x', sizeof(long_text) - 1);
+	long_text[sizeof(long_text) - 1] = '\0';
+	LOG_AND_EXPECT("long %s", long_text);
+
+	// fields are recorded as text behind the log message
+	write_to_log_kv(LOG_INFO, "fields", "key", "value", "quote", "\"", NULL);
+	_expect("fields key=\"value\" quote=\"\\\"\"");
+
+	// the same format string again: it's only written once into the log file
+	LOG_AND_EXPECT("int %d, negative %i, unsigned %u, hex %#x, char %c, percent %%", 8, -13, 1u, 16, 'a');
+
+	dispose();
+
+	FILE *decoded = _decode(LOG_FILE);
+	static char line[4 * LENGTH_LOG_MESSAGE];
+	bool valid = decoded != NULL;
+	int i = 0;
+
+	while (valid && fgets(line, sizeof(line), decoded) != NULL) {
+		// "[YYYY-MM-DD HH:MM:SS.mmm] [INFO] message"
+		char *message = strstr(line, "] [INFO] ");
+		line[strcspn(line, "\n")] = '\0';
+
+		if (message == NULL || line[0] != '[' || i >= _nbr_of_expected || strcmp(message + 9, _expected[i]) != 0) {
+			fprintf(stderr, "decoded: %.120s\nexpected: %.120s\n", line, i < _nbr_of_expected ? _expected[i] : "nothing");
+			valid = false;
+		}
+
+		i++;
+	}
+
+	if (decoded != NULL) {
+		fclose(decoded);
+	}
+
+	valid = valid && i == _nbr_of_expected;
+	printf("binary format: %d log events decoded: %s\n", i, valid ? "passed" : "FAILED");
+	return valid;
+}
+
+/// @brief A callsite from LOG_CALLSITE_() with a long log message: its source location is recorded as text fields
+///        behind the log message, which must be kept. The log event is cut at LENGTH_LOG_MESSAGE.
+static bool _check_long_callsite(Logging *log) {
+	_remove_log_files();
+	init_log(log);
+
+	char long_text[2000];
+	memset(long_text, 'y', sizeof(long_text) - 1);
+	long_text[sizeof(long_text) - 1] = '\0';
+	LOG_CALLSITE_(LOG_INFO, "long callsite %s", long_text);
+	dispose();
+
+	FILE *decoded = _decode(LOG_FILE);
+	static char line[4 * LENGTH_LOG_MESSAGE];
+	bool valid = decoded != NULL && fgets(line, sizeof(line), decoded) != NULL;
+
+	if (valid) {
+		char *message = strstr(line, "] [INFO] long callsite ");
+		valid = message != NULL && strspn(message + 23, "y") >= LENGTH_LOG_MESSAGE / 2;
+	}
+
+	if (decoded != NULL) {
+		fclose(decoded);
+	}
+
+	printf("binary format: long callsite: %s\n", valid ? "passed" : "FAILED");
+	return valid;
+}
+
+/// @brief A log event after dispose() reopens the log file and is still recorded in the binary format.
+static bool _check_write_after_dispose(Logging *log) {
+	_remove_log_files();
+	init_log(log);
+
+	write_to_log(LOG_INFO, "before dispose %d", 1);
+	dispose();
+	write_to_log(LOG_INFO, "after dispose %d", 2);
+	write_to_log(LOG_INFO, "before dispose %d", 3);
+	dispose();
+
+	FILE *decoded = _decode(LOG_FILE);
+	static char line[4 * LENGTH_LOG_MESSAGE];
+	const char *expected[] = {"before dispose 1", "after dispose 2", "before dispose 3"};
+	bool valid = decoded != NULL;
+	int i = 0;
+
+	while (valid && fgets(line, sizeof(line), decoded) != NULL) {
+		line[strcspn(line, "\n")] = '\0';
+		valid = i < 3 && strstr(line, "] [INFO] ") != NULL && strcmp(strstr(line, "] [INFO] ") + 9, expected[i]) == 0;
+		i++;
+	}
+
+	if (decoded != NULL) {
+		fclose(decoded);
+	}
+
+	valid = valid && i == 3;
+	printf("binary format: write after dispose: %s\n", valid ? "passed" : "FAILED");
+	return valid;
+}
+
+/// @brief Write LINES_FOR_SPEED log events with rotations. Every rotated binary file must be decoded on its own.
+///        Text log files are only written for a comparison of the time.
+static bool _check_rotations(Logging *log, const char *description) {
+	_remove_log_files();
+	init_log(log);
+
+	double start = _now_in_seconds();
+
+	for (int i = 0; i < LINES_FOR_SPEED; i++) {
+		write_to_log(LOG_INFO, "line %06d of %s with %.2f%% done", i, "writer", 100.0 * i / LINES_FOR_SPEED);
+	}
+
+	dispose();
+	double elapsed = _now_in_seconds() - start;
+
+	char name[64];
+	char line[256];
+	int next_line = log->binary_format ? 0 : LINES_FOR_SPEED;
+	bool valid = true;
+
+	// the rotated files from the oldest to the newest, then the current log file
+	for (int i = KEEPING_FILES; i >= 0 && valid && log->binary_format; i--) {
+		if (i > 0) {
+			snprintf(name, sizeof(name), "%s.%d", LOG_FILE, i);
+		} else {
+			snprintf(name, sizeof(name), "%s", LOG_FILE);
+		}
+
+		FILE *file = fopen(name, "rb");
+
+		if (file == NULL) {
+			continue;
+		}
+
+		fclose(file);
+		FILE *decoded = _decode(name);
+		valid = decoded != NULL;
+
+		while (valid && fgets(line, sizeof(line), decoded) != NULL) {
+			int number = -1;
+			valid = sscanf(strstr(line, "] [INFO] ") + 9, "line %d of writer", &number) == 1 && number == next_line++;
+		}
+
+		if (decoded != NULL) {
+			fclose(decoded);
+		}
+	}
+
+	valid = valid && next_line == LINES_FOR_SPEED;
+	printf(
+		"%-22s %d lines: %.3f s (%.0f lines/s): %s\n",
+		description, LINES_FOR_SPEED, elapsed, LINES_FOR_SPEED / elapsed, valid ? "passed" : "FAILED"
+	);
+
+	return valid;
+}
+
+int main(void) {
+	// Create a new log construction.
+	// NOTE: With binary_format a log event isn't formatted at all. Only the number of its format string,
+	//       the time, the level and the raw arguments are written. The log file is rendered as text by
+	//       decode_binary_log() or by the decoder: make decoder && ./log_decoder.run binary.log
+	Logging log = {
+		.on_console_only = false,
+		.init_level = LOG_INFO,
+		.file_name = LOG_FILE,
+		.rotation_setting = NO_ROTATION,
+		.keep_file_open = true,
+		.timestamp_precision = TIMESTAMP_MILLISECONDS,
+		.binary_format = true
+	};
+
+	bool valid = _check_conversions(&log);
+	valid = _check_long_callsite(&log) && valid;
+	valid = _check_write_after_dispose(&log) && valid;
+
+	log.rotation_setting = SIZE_ROTATION;
+	log.nbr_of_keeping_files = KEEPING_FILES;
+	log.file_size_in_mb = 1;
+	log.binary_format = false;
+	valid = _check_rotations(&log, "text:") && valid;
+
+	log.binary_format = true;
+	valid = _check_rotations(&log, "binary:") && valid;
+
+	log.batch_mode = true;
+	valid = _check_rotations(&log, "binary, batch mode:") && valid;
+
+	log.batch_mode = false;
+	log.async_mode = true;
+	valid = _check_rotations(&log, "binary, async mode:") && valid;
+
+	_remove_log_files();
+	return valid ? EXIT_SUCCESS : EXIT_FAILURE;
+}
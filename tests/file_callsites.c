@@ -0,0 +1,159 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include "logging.h"
+
+#define LOG_FILE          "callsites.log"
+#define LINES_FOR_SPEED   200000
+
+/// @brief Number of evaluated arguments of disabled callsites.
+static int _evaluated = 0;
+
+/// @brief Returns the current wall clock time in seconds.
+static double _now_in_seconds(void) {
+	struct timespec ts;
+	timespec_get(&ts, TIME_UTC);
+	return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+/// @brief Read the whole log file.
+static bool _read_log_file(char *content, size_t size) {
+	FILE *file = fopen(LOG_FILE, "r");
+	size_t length = file != NULL ? fread(content, 1, size - 1, file) : 0;
+	content[length] = '\0';
+
+	if (file != NULL) {
+		fclose(file);
+	}
+
+	return file != NULL;
+}
+
+/// @brief A callsite, which is called by several checks. Returns its line.
+static int _shared_callsite(int value) {
+	LOG_CALLSITE_(LOG_INFO, "shared callsite %d", value); return __LINE__;
+}
+
+/// @brief A callsite, which is registered after a rule for every callsite.
+static void _late_callsite(void) {
+	LOG_CALLSITE_(LOG_WARNING, "late callsite %d", ++_evaluated);
+}
+
+/// @brief Count the registered callsites of this file and check their static descriptors.
+static void _count_callsite(const LogCallsite *callsite, void *context) {
+	int *counts = context;
+
+	if (strcmp(callsite->file, __FILE__) == 0) {
+		counts[0]++;
+		counts[1] += callsite->level == LOG_INFO && strcmp(callsite->format, "shared callsite %d") == 0 &&
+			strcmp(callsite->function, "_shared_callsite") == 0;
+	}
+}
+
+/// @brief Each log line carries the location of its callsite. A disabled callsite doesn't evaluate its arguments.
+static bool _check_locations(Logging *log, const char *description) {
+	static char content[8192];
+	char expected[1024];
+	bool json = log->json_lines;
+
+	remove(LOG_FILE);
+	init_log(log);
+	_evaluated = 0;
+
+	int line = _shared_callsite(1);
+	LOG_CALLSITE_(LOG_DEBUG, "below the log level %d", ++_evaluated);
+
+	// only the shared callsite is disabled, a callsite in another file doesn't exist
+	int matches = set_log_callsites_enabled("file_callsites.c", line, false);
+	int no_matches = set_log_callsites_enabled("other_file_callsites.c", 0, false);
+	_shared_callsite(2);
+
+	set_log_callsites_enabled("file_callsites.c", line, true);
+	_shared_callsite(3);
+
+	// a rule for every callsite is applied to a callsite, which is registered afterwards
+	set_log_callsites_enabled(NULL, 0, false);
+	_late_callsite();
+	set_log_callsites_enabled(NULL, 0, true);
+	_late_callsite();
+
+	int counts[2] = {0, 0};
+	visit_log_callsites(_count_callsite, counts);
+	dispose();
+
+	bool valid = _read_log_file(content, sizeof(content)) && matches == 1 && no_matches == 0 && _evaluated == 1 &&
+		counts[0] == 2 && counts[1] == 1;
+
+	if (json) {
+		snprintf(expected, sizeof(expected), "\"level\":\"INFO\",\"message\":\"shared callsite 1\",\"source\":\"%s:%d\",\"function\":\"_shared_callsite\"}\n", __FILE__, line);
+	} else {
+		snprintf(expected, sizeof(expected), "] [INFO] shared callsite 1 source=\"%s:%d\" function=\"_shared_callsite\"\n", __FILE__, line);
+	}
+
+	valid = valid && strstr(content, expected) != NULL && strstr(content, "shared callsite 2") == NULL &&
+		strstr(content, "shared callsite 3") != NULL && strstr(content, "late callsite 1") != NULL &&
+		strstr(content, "below the log level") == NULL;
+
+	if (!valid) {
+		fprintf(stderr, "written:\n%s\nexpected:\n%s", content, expected);
+	}
+
+	printf("%-22s %d registered callsites: %s\n", description, counts[0], valid ? "passed" : "FAILED");
+	return valid;
+}
+
+/// @brief Compare the time of a callsite with its location as fields with write_to_log() and the location as arguments.
+static void _compare_speed(Logging *log) {
+	for (int callsite = 0; callsite <= 1; callsite++) {
+		remove(LOG_FILE);
+		init_log(log);
+
+		double start = _now_in_seconds();
+
+		for (int i = 0; i < LINES_FOR_SPEED; i++) {
+			if (callsite) {
+				LOG_CALLSITE_(LOG_INFO, "line %06d of %s", i, "writer");
+			} else {
+				write_to_log(LOG_INFO, "line %06d of %s source=\"%s:%d\" function=\"%s\"", i, "writer", __FILE__, __LINE__, __func__);
+			}
+		}
+
+		dispose();
+		double elapsed = _now_in_seconds() - start;
+		printf(
+			"%-22s %d lines: %.3f s (%.0f lines/s)\n",
+			callsite ? "LOG_CALLSITE_():" : "location arguments:", LINES_FOR_SPEED, elapsed, LINES_FOR_SPEED / elapsed
+		);
+	}
+}
+
+int main(void) {
+	// Create a new log construction.
+	// NOTE: LOG_CALLSITE_() keeps the level, file, line, function and format string in a static descriptor of its
+	//       callsite. The location is written as fields without any formatting: source="file.c:42" function="main"
+	//       Each callsite can be enabled or disabled at runtime by set_log_callsites_enabled().
+	Logging log = {
+		.on_console_only = false,
+		.init_level = LOG_INFO,
+		.file_name = LOG_FILE,
+		.rotation_setting = NO_ROTATION,
+		.keep_file_open = true
+	};
+
+	bool valid = _check_locations(&log, "text:");
+
+	log.json_lines = true;
+	valid = _check_locations(&log, "JSON lines:") && valid;
+
+	log.json_lines = false;
+	log.async_mode = true;
+	valid = _check_locations(&log, "async mode:") && valid;
+
+	log.async_mode = false;
+	_compare_speed(&log);
+
+	remove(LOG_FILE);
+	return valid ? EXIT_SUCCESS : EXIT_FAILURE;
+}
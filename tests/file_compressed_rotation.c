@@ -0,0 +1,114 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include "logging.h"
+
+#define LOG_FILE         "compressed.log"
+#define KEEPING_FILES    5
+#define ROTATIONS        8
+#define LOG_MESSAGE      "This is a simple message, which fills the log file up to the next rotation."
+
+/// @brief Check, if a file exists.
+static bool _file_exists(const char *file_name) {
+	FILE *file = fopen(file_name, "r");
+
+	if (file == NULL) {
+		return false;
+	}
+
+	fclose(file);
+	return true;
+}
+
+/// @brief Remove the log file and every rotated file of both namings.
+static void _remove_log_files(void) {
+	char name[64];
+	remove(LOG_FILE);
+
+	for (int i = 0; i <= ROTATIONS; i++) {
+		snprintf(name, sizeof(name), "%s.%d.gz", LOG_FILE, i);
+		remove(name);
+		snprintf(name, sizeof(name), "%s.%d", LOG_FILE, i);
+		remove(name);
+		snprintf(name, sizeof(name), "%s.%06d.gz", LOG_FILE, i);
+		remove(name);
+		snprintf(name, sizeof(name), "%s.%06d", LOG_FILE, i);
+		remove(name);
+	}
+}
+
+/// @brief Write enough log events for ROTATIONS rotations of 1 MB and count the compressed files.
+/// @param format name of a rotated file, ".gz" is appended for a compressed one
+/// @param plain_files receives the number of rotated files, which haven't been compressed
+static int _run_rotations(Logging *log, const char *format, int *plain_files) {
+	char name[64];
+	int compressed_files = 0;
+	*plain_files = 0;
+
+	_remove_log_files();
+	init_log(log);
+
+	for (long long bytes = 0; bytes < (long long)ROTATIONS * 1024 * 1024; bytes += (long long)strlen(LOG_MESSAGE) + 30) {
+		write_to_log(LOG_INFO, LOG_MESSAGE);
+	}
+
+	// waits, until every rotated file has been compressed
+	dispose();
+
+	for (int i = 0; i <= ROTATIONS; i++) {
+		snprintf(name, sizeof(name), format, LOG_FILE, i);
+		*plain_files += _file_exists(name);
+		strcat(name, ".gz");
+		compressed_files += _file_exists(name);
+	}
+
+	return compressed_files;
+}
+
+int main(void) {
+	// Create a new log construction.
+	// NOTE: Every rotated file is compressed by a background thread, e.g. "compressed.log.1.gz".
+	//       The compression is only available, if this file and logging.c have been built with:
+	//       gcc -DLOG_WITH_ZLIB ... -lz
+	Logging log = {
+		.on_console_only = false,
+		.init_level = LOG_INFO,
+		.file_name = LOG_FILE,
+		.rotation_setting = SIZE_ROTATION,
+		.nbr_of_keeping_files = KEEPING_FILES,
+		.file_size_in_mb = 1,
+		.keep_file_open = true,
+		.compress_rotated_files = true
+	};
+
+	int shift_plain_files = 0;
+	int sequence_plain_files = 0;
+
+	log.rotation_naming = NAMING_SHIFT;
+	int shift_files = _run_rotations(&log, "%s.%d", &shift_plain_files);
+
+	log.rotation_naming = NAMING_SEQUENCE;
+	int sequence_files = _run_rotations(&log, "%s.%06d", &sequence_plain_files);
+	_remove_log_files();
+
+	#ifndef LOG_WITH_ZLIB
+	// without zlib the rotated files must be kept as they are
+	bool uncompressed = shift_files == 0 && sequence_files == 0 &&
+		shift_plain_files == KEEPING_FILES - 1 && sequence_plain_files == KEEPING_FILES - 1;
+
+	printf(
+		"compressed files: skipped: built without zlib, uncompressed files: NAMING_SHIFT: %d, NAMING_SEQUENCE: %d: %s\n",
+		shift_plain_files, sequence_plain_files, uncompressed ? "passed" : "FAILED"
+	);
+
+	return uncompressed ? EXIT_SUCCESS : EXIT_FAILURE;
+	#else
+	// a compressed file replaces its rotated file
+	bool valid = shift_files == KEEPING_FILES - 1 && sequence_files == KEEPING_FILES - 1 &&
+		shift_plain_files == 0 && sequence_plain_files == 0;
+
+	printf("compressed files: NAMING_SHIFT: %d, NAMING_SEQUENCE: %d: %s\n", shift_files, sequence_files, valid ? "passed" : "FAILED");
+	return valid ? EXIT_SUCCESS : EXIT_FAILURE;
+	#endif
+}
@@ -0,0 +1,264 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include "logging.h"
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <pthread.h>
+#endif
+
+#define LOG_FILE          "recorder.log"
+#define NBR_OF_THREADS    4
+#define KEPT_EVENTS       1000
+
+/// @brief Padding of different lengths, so the kept log events wrap around at different places.
+static const char *_padding = "................................................................................"
+                              "................................................................................";
+
+/// @brief Keeps KEPT_EVENTS TRACE log events of different lengths. Only the thread with the id 0 logs an error afterwards.
+#ifdef _WIN32
+static DWORD WINAPI _writer(LPVOID argument) {
+#else
+static void *_writer(void *argument) {
+#endif
+	int thread_id = (int)(size_t)argument;
+
+	for (int i = 0; i < KEPT_EVENTS; i++) {
+		write_to_log(LOG_TRACE, "thread %d trace %04d %.*s", thread_id, i, (i * 37) % 160, _padding);
+	}
+
+	if (thread_id == 0) {
+		write_to_log(LOG_ERROR, "thread %d failed", thread_id);
+	}
+
+	return 0;
+}
+
+/// @brief Keeps a DEBUG log event. With an argument the thread logs an error afterwards.
+#ifdef _WIN32
+static DWORD WINAPI _short_lived_writer(LPVOID argument) {
+#else
+static void *_short_lived_writer(void *argument) {
+#endif
+	if (argument == NULL) {
+		write_to_log(LOG_DEBUG, "kept by a finished thread");
+	} else {
+		write_to_log(LOG_DEBUG, "kept by a new thread");
+		write_to_log(LOG_ERROR, "failure of a new thread");
+	}
+
+	return 0;
+}
+
+/// @brief Run a single thread and wait for it.
+static void _run_thread_once(void *argument) {
+	#ifdef _WIN32
+	HANDLE thread = CreateThread(NULL, 0, _short_lived_writer, argument, 0, NULL);
+	WaitForSingleObject(thread, INFINITE);
+	CloseHandle(thread);
+	#else
+	pthread_t thread;
+	pthread_create(&thread, NULL, _short_lived_writer, argument);
+	pthread_join(thread, NULL);
+	#endif
+}
+
+/// @brief Start NBR_OF_THREADS threads, which are writing at the same time, and wait for them.
+static void _run_writers(void) {
+	#ifdef _WIN32
+	HANDLE threads[NBR_OF_THREADS];
+
+	for (int i = 0; i < NBR_OF_THREADS; i++) {
+		threads[i] = CreateThread(NULL, 0, _writer, (LPVOID)(size_t)i, 0, NULL);
+	}
+
+	WaitForMultipleObjects(NBR_OF_THREADS, threads, TRUE, INFINITE);
+
+	for (int i = 0; i < NBR_OF_THREADS; i++) {
+		CloseHandle(threads[i]);
+	}
+	#else
+	pthread_t threads[NBR_OF_THREADS];
+
+	for (int i = 0; i < NBR_OF_THREADS; i++) {
+		pthread_create(&threads[i], NULL, _writer, (void *)(size_t)i);
+	}
+
+	for (int i = 0; i < NBR_OF_THREADS; i++) {
+		pthread_join(threads[i], NULL);
+	}
+	#endif
+}
+
+/// @brief The log file must contain the INFO log events, then the newest kept TRACE log events of thread 0 in their
+///        order and the error at last. A TRACE log event of another thread must not be written.
+static bool _verify_log_file(const char *description) {
+	FILE *file = fopen(LOG_FILE, "r");
+	char buffer[512];
+	int info_lines = 0;
+	int first_trace = -1;
+	int next_trace = -1;
+	int error_lines = 0;
+	bool kept_by_main_thread = false;
+	bool valid = file != NULL;
+
+	while (valid && fgets(buffer, sizeof(buffer), file) != NULL) {
+		int thread_id = -1;
+		int number = -1;
+
+		if (strstr(buffer, "] [INFO] written") != NULL && first_trace < 0 && error_lines == 0) {
+			info_lines++;
+		} else if (sscanf(strstr(buffer, "] [TRACE] ") != NULL ? strstr(buffer, "] [TRACE] ") + 10 : "", "thread %d trace %d", &thread_id, &number) == 2) {
+			// a contiguous sequence of the newest log events of thread 0, each one complete
+			const char *padding = strchr(strstr(buffer, " trace ") + 7, ' ') + 1;
+			valid = thread_id == 0 && error_lines == 0 && (next_trace < 0 || number == next_trace) &&
+				strspn(padding, ".") == (size_t)((number * 37) % 160) && strcmp(padding + strspn(padding, "."), "\n") == 0;
+			first_trace = first_trace < 0 ? number : first_trace;
+			next_trace = number + 1;
+		} else if (strstr(buffer, "] [ERROR] thread 0 failed") != NULL) {
+			error_lines++;
+		} else if (strstr(buffer, "] [DEBUG] kept by the main thread") != NULL) {
+			// kept before the threads have been started, but written by the error of the main thread
+			valid = error_lines == 1 && !kept_by_main_thread;
+			kept_by_main_thread = true;
+		} else if (strstr(buffer, "] [ERROR] second failure") != NULL) {
+			valid = error_lines == 1 && kept_by_main_thread;
+			error_lines++;
+		} else {
+			valid = false;
+		}
+
+		if (!valid) {
+			fprintf(stderr, "unexpected: %s", buffer);
+		}
+	}
+
+	if (file != NULL) {
+		fclose(file);
+	}
+
+	valid = valid && info_lines == 2 && first_trace > 0 && next_trace == KEPT_EVENTS && error_lines == 2;
+	printf(
+		"%-22s %d of %d TRACE log events written before the error: %s\n",
+		description, next_trace - first_trace, KEPT_EVENTS, valid ? "passed" : "FAILED"
+	);
+
+	return valid;
+}
+
+/// @brief Write log events below and above the log level by many threads and check the log file.
+static bool _run(Logging *log, const char *description) {
+	remove(LOG_FILE);
+	init_log(log);
+
+	write_to_log(LOG_INFO, "written %d", 1);
+	write_to_log(LOG_DEBUG, "kept by the main thread");
+	write_to_log(LOG_INFO, "written %d", 2);
+
+	_run_writers();
+
+	// only the log event of this thread, the other threads are independent
+	write_to_log(LOG_ERROR, "second failure");
+	dispose();
+
+	return _verify_log_file(description);
+}
+
+/// @brief A kept log event from write_to_log_kv() must be written with its fields and its own time.
+static bool _check_fields(Logging *log) {
+	remove(LOG_FILE);
+	init_log(log);
+
+	write_to_log_kv(LOG_DEBUG, "request received", "path", "/index.html", "status", "pending", NULL);
+	write_to_log(LOG_FATAL, "out of memory");
+	dispose();
+
+	FILE *file = fopen(LOG_FILE, "r");
+	char first[512] = {0};
+	char second[512] = {0};
+	bool valid = file != NULL && fgets(first, sizeof(first), file) != NULL && fgets(second, sizeof(second), file) != NULL;
+
+	if (file != NULL) {
+		valid = valid && fgetc(file) == EOF;
+		fclose(file);
+	}
+
+	// "{"time":"YYYY-MM-DD HH:MM:SS.mmm","level":...": the kept log event isn't newer than the fatal one
+	valid = valid &&
+		strstr(first, "\"level\":\"DEBUG\",\"message\":\"request received\",\"path\":\"/index.html\",\"status\":\"pending\"}") != NULL &&
+		strstr(second, "\"level\":\"FATAL\",\"message\":\"out of memory\"}") != NULL &&
+		strncmp(first, second, 32) <= 0;
+
+	printf("%-22s kept log event with fields: %s\n", "JSON lines:", valid ? "passed" : "FAILED");
+	return valid;
+}
+
+/// @brief A new thread may get the thread local memory of a finished thread. It must not write the kept log events
+///        of the finished thread.
+static bool _check_reused_threads(Logging *log) {
+	remove(LOG_FILE);
+	init_log(log);
+
+	_run_thread_once(NULL);
+	_run_thread_once((void *)log);
+	dispose();
+
+	FILE *file = fopen(LOG_FILE, "r");
+	char buffer[512];
+	int kept_lines = 0;
+	int own_lines = 0;
+	int error_lines = 0;
+
+	while (file != NULL && fgets(buffer, sizeof(buffer), file) != NULL) {
+		kept_lines += strstr(buffer, "kept by a finished thread") != NULL;
+		own_lines += strstr(buffer, "kept by a new thread") != NULL;
+		error_lines += strstr(buffer, "failure of a new thread") != NULL;
+	}
+
+	if (file != NULL) {
+		fclose(file);
+	}
+
+	bool valid = kept_lines == 0 && own_lines == 1 && error_lines == 1;
+	printf("%-22s %d kept log events of a finished thread written: %s\n", "new threads:", kept_lines, valid ? "passed" : "FAILED");
+	return valid;
+}
+
+int main(void) {
+	// Create a new log construction.
+	// NOTE: With flight_recorder every log event from flight_recorder_level up to init_level is only kept in the
+	//       memory of its thread. A LOG_ERROR or LOG_FATAL log event writes the kept log events of its thread
+	//       before itself, so the context of a failure is logged without writing every TRACE log event.
+	Logging log = {
+		.on_console_only = false,
+		.init_level = LOG_INFO,
+		.file_name = LOG_FILE,
+		.rotation_setting = NO_ROTATION,
+		.keep_file_open = true,
+		.flight_recorder = true,
+		.flight_recorder_level = LOG_TRACE,
+		.flight_recorder_size_in_kb = 16
+	};
+
+	bool valid = _run(&log, "caller's thread:");
+
+	log.batch_mode = true;
+	valid = _run(&log, "batch mode:") && valid;
+
+	log.batch_mode = false;
+	log.async_mode = true;
+	valid = _run(&log, "async mode:") && valid;
+
+	log.async_mode = false;
+	valid = _check_reused_threads(&log) && valid;
+
+	log.json_lines = true;
+	log.timestamp_precision = TIMESTAMP_MILLISECONDS;
+	valid = _check_fields(&log) && valid;
+
+	remove(LOG_FILE);
+	return valid ? EXIT_SUCCESS : EXIT_FAILURE;
+}
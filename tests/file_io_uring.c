@@ -0,0 +1,277 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include "logging.h"
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <pthread.h>
+#endif
+
+#define NBR_OF_THREADS    4
+#define LINES_PER_THREAD  50000
+#define KEEPING_FILES     100
+#define LOG_FILE          "uring.log"
+#define LONG_LINES        100
+#define LONG_LINE_LENGTH  4000
+#define DECODED_FILE      "uring_decoded.log"
+
+/// @brief Returns the current wall clock time in seconds.
+static double _now_in_seconds(void) {
+	struct timespec ts;
+	timespec_get(&ts, TIME_UTC);
+	return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+/// @brief Every thread writes LINES_PER_THREAD numbered log events.
+#ifdef _WIN32
+static DWORD WINAPI _writer(LPVOID argument) {
+#else
+static void *_writer(void *argument) {
+#endif
+	int thread_id = (int)(size_t)argument;
+
+	for (int line = 0; line < LINES_PER_THREAD; line++) {
+		write_to_log(LOG_INFO, "thread %02d line %06d payload-%s", thread_id, line, "0123456789abcdefghijklmnopqrstuvwxyz");
+	}
+
+	return 0;
+}
+
+/// @brief Start NBR_OF_THREADS threads, which are writing at the same time, and wait for them.
+static void _run_writers(void) {
+	#ifdef _WIN32
+	HANDLE threads[NBR_OF_THREADS];
+
+	for (int i = 0; i < NBR_OF_THREADS; i++) {
+		threads[i] = CreateThread(NULL, 0, _writer, (LPVOID)(size_t)i, 0, NULL);
+	}
+
+	WaitForMultipleObjects(NBR_OF_THREADS, threads, TRUE, INFINITE);
+
+	for (int i = 0; i < NBR_OF_THREADS; i++) {
+		CloseHandle(threads[i]);
+	}
+	#else
+	pthread_t threads[NBR_OF_THREADS];
+
+	for (int i = 0; i < NBR_OF_THREADS; i++) {
+		pthread_create(&threads[i], NULL, _writer, (void *)(size_t)i);
+	}
+
+	for (int i = 0; i < NBR_OF_THREADS; i++) {
+		pthread_join(threads[i], NULL);
+	}
+	#endif
+}
+
+/// @brief Read a log file and count the lines of each thread. Every line must be complete and the
+///        lines of a thread must be in their order, even if the batches are written by the kernel.
+/// @param next_line_of_thread the next expected line of each thread; continued by the next log file
+/// @return true, if the log file is valid or doesn't exist, otherwise false
+static bool _verify_log_file(const char *file_name, int *next_line_of_thread) {
+	FILE *file = fopen(file_name, "rb");
+
+	if (file == NULL) {
+		return true;
+	}
+
+	char buffer[512];
+	bool valid = true;
+
+	while (fgets(buffer, sizeof(buffer), file) != NULL) {
+		int thread_id = -1;
+		int line = -1;
+		char payload[64] = {0};
+		char end = '\0';
+
+		// "[YYYY-MM-DD HH:MM:SS] [INFO] thread xx line yyyyyy payload-..."
+		int matched = sscanf(buffer, "[%*19c] [INFO] thread %d line %d payload-%63s%c", &thread_id, &line, payload, &end);
+
+		if (
+			matched != 4 || end != '\n' || thread_id < 0 || thread_id >= NBR_OF_THREADS ||
+			strcmp(payload, "0123456789abcdefghijklmnopqrstuvwxyz") != 0
+		) {
+			fprintf(stderr, "%s: torn line: %s\n", file_name, buffer);
+			valid = false;
+			continue;
+		}
+
+		if (line != next_line_of_thread[thread_id]) {
+			fprintf(stderr, "%s: thread %d: line %d instead of %d\n", file_name, thread_id, line, next_line_of_thread[thread_id]);
+			valid = false;
+		}
+
+		next_line_of_thread[thread_id] = line + 1;
+	}
+
+	fclose(file);
+	return valid;
+}
+
+/// @brief Remove the log file and every rotated file.
+static void _remove_log_files(void) {
+	char name[64];
+	remove(LOG_FILE);
+
+	for (int i = 0; i < KEEPING_FILES; i++) {
+		snprintf(name, sizeof(name), "%s.%06d", LOG_FILE, i);
+		remove(name);
+	}
+}
+
+/// @brief Write the log events of every thread and check every log file afterwards.
+static bool _run(Logging *log, const char *description) {
+	_remove_log_files();
+	init_log(log);
+
+	double start = _now_in_seconds();
+	_run_writers();
+	dispose();
+	double elapsed = _now_in_seconds() - start;
+
+	int next_line_of_thread[NBR_OF_THREADS] = {0};
+	char name[64];
+	bool valid = true;
+
+	// the rotated files from the oldest to the newest, then the current log file
+	for (int i = 0; i < KEEPING_FILES; i++) {
+		snprintf(name, sizeof(name), "%s.%06d", LOG_FILE, i);
+		valid = _verify_log_file(name, next_line_of_thread) && valid;
+	}
+
+	valid = _verify_log_file(LOG_FILE, next_line_of_thread) && valid;
+
+	for (int i = 0; i < NBR_OF_THREADS; i++) {
+		if (next_line_of_thread[i] != LINES_PER_THREAD) {
+			fprintf(stderr, "thread %d: %d of %d lines found\n", i, next_line_of_thread[i], LINES_PER_THREAD);
+			valid = false;
+		}
+	}
+
+	printf(
+		"%-10s %d threads x %d lines: %.3f s (%.0f lines/s): %s\n",
+		description, NBR_OF_THREADS, LINES_PER_THREAD, elapsed, NBR_OF_THREADS * LINES_PER_THREAD / elapsed, valid ? "passed" : "FAILED"
+	);
+
+	return valid;
+}
+
+/// @brief Count the short and the complete long log lines of a text file in their order.
+/// @param min_padding the padding of a long log line may be cut after this length
+/// @return true, if every line is in its order
+static bool _count_long_lines(const char *file_name, size_t min_padding, int *short_lines, int *long_lines) {
+	static char buffer[LONG_LINE_LENGTH + 512];
+	FILE *file = fopen(file_name, "r");
+	bool valid = file != NULL;
+	int number = -1;
+
+	*short_lines = 0;
+	*long_lines = 0;
+
+	while (file != NULL && fgets(buffer, sizeof(buffer), file) != NULL) {
+		const char *message = strstr(buffer, "] [INFO] ");
+
+		if (message != NULL && sscanf(message + 9, "short %d", &number) == 1) {
+			valid = valid && number == *short_lines;
+			(*short_lines)++;
+		} else if (message != NULL && sscanf(message + 9, "long %d", &number) == 1) {
+			const char *padding = strchr(message + 9 + 5, ' ') + 1;
+			size_t length = strspn(padding, "x");
+			valid = valid && number == *long_lines && length >= min_padding && length <= LONG_LINE_LENGTH && strcmp(padding + length, "\n") == 0;
+			(*long_lines)++;
+		} else {
+			valid = false;
+		}
+	}
+
+	if (file != NULL) {
+		fclose(file);
+	}
+
+	return valid;
+}
+
+/// @brief A log line, which is longer than a whole batch, is written directly behind the batches. No log line may be
+///        overwritten by a following batch.
+static bool _check_long_lines(Logging *log, const char *description) {
+	static char padding[LONG_LINE_LENGTH + 1];
+	memset(padding, 'x', LONG_LINE_LENGTH);
+
+	remove(LOG_FILE);
+	init_log(log);
+
+	for (int i = 0; i < LONG_LINES; i++) {
+		write_to_log(LOG_INFO, "short %d", i);
+		write_to_log(LOG_INFO, "long %d %s", i, padding);
+	}
+
+	dispose();
+
+	const char *text_file = LOG_FILE;
+	size_t min_padding = LONG_LINE_LENGTH;
+	bool valid = true;
+
+	if (log->binary_format) {
+		FILE *decoded = fopen(DECODED_FILE, "w");
+		valid = decoded != NULL && decode_binary_log(LOG_FILE, decoded);
+
+		if (decoded != NULL) {
+			fclose(decoded);
+		}
+
+		// a string argument is cut at LENGTH_LOG_MESSAGE, the record is still longer than a batch
+		text_file = DECODED_FILE;
+		min_padding = 1000;
+	}
+
+	int short_lines = 0;
+	int long_lines = 0;
+	valid = _count_long_lines(text_file, min_padding, &short_lines, &long_lines) && valid && short_lines == LONG_LINES && long_lines == LONG_LINES;
+
+	printf(
+		"%-10s %d of %d short and %d of %d long lines: %s\n",
+		description, short_lines, LONG_LINES, long_lines, LONG_LINES, valid ? "passed" : "FAILED"
+	);
+
+	remove(DECODED_FILE);
+	return valid;
+}
+
+int main(void) {
+	// Create a new log construction.
+	// NOTE: With io_uring_files each full batch is handed over to the kernel and written in the background.
+	//       Every batch has its own position in the log file, so the log lines keep their order. Without
+	//       io_uring (e.g. not on Linux), the same log lines are written as usual.
+	Logging log = {
+		.on_console_only = false,
+		.init_level = LOG_INFO,
+		.file_name = LOG_FILE,
+		.rotation_setting = SIZE_ROTATION,
+		.rotation_naming = NAMING_SEQUENCE,
+		.nbr_of_keeping_files = KEEPING_FILES,
+		.file_size_in_mb = 1,
+		.batch_size_in_kb = 16,
+		.io_uring_files = true
+	};
+
+	bool valid = _run(&log, "io_uring:");
+
+	log.async_mode = true;
+	valid = _run(&log, "async:") && valid;
+
+	// every long log line is longer than a batch of 1 KB
+	log.async_mode = false;
+	log.rotation_setting = NO_ROTATION;
+	log.batch_size_in_kb = 1;
+	valid = _check_long_lines(&log, "long:") && valid;
+
+	log.binary_format = true;
+	valid = _check_long_lines(&log, "binary:") && valid;
+
+	_remove_log_files();
+	return valid ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,217 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include "logging.h"
+
+#define LOG_FILE          "json.log"
+#define NBR_OF_EXPECTED   16
+#define LENGTH_EXPECTED   (8 * LENGTH_LOG_MESSAGE)
+#define LENGTH_TIMESTAMP_IN_LINE 19
+#define LINES_FOR_SPEED   200000
+
+/// @brief Every log line, which is expected in the log file, without its timestamp.
+static char _expected[NBR_OF_EXPECTED][LENGTH_EXPECTED];
+static int _nbr_of_expected = 0;
+
+/// @brief Returns the current wall clock time in seconds.
+static double _now_in_seconds(void) {
+	struct timespec ts;
+	timespec_get(&ts, TIME_UTC);
+	return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+/// @brief Escape a string for JSON character by character, independent of the library.
+static void _append_escaped(char *destination, const char *text) {
+	char *end = destination + strlen(destination);
+
+	for (const unsigned char *c = (const unsigned char *)text; *c != '\0'; c++) {
+		switch (*c) {
+			case '"':  end += sprintf(end, "\\\""); break;
+			case '\\': end += sprintf(end, "\\\\"); break;
+			case '\n': end += sprintf(end, "\\n"); break;
+			case '\r': end += sprintf(end, "\\r"); break;
+			case '\t': end += sprintf(end, "\\t"); break;
+			case '\b': end += sprintf(end, "\\b"); break;
+			case '\f': end += sprintf(end, "\\f"); break;
+			default:
+				if (*c < 0x20) {
+					end += sprintf(end, "\\u%04x", *c);
+				} else {
+					*end++ = (char)*c;
+					*end = '\0';
+				}
+		}
+	}
+}
+
+/// @brief Keep the log line, which is expected for a log message and its fields (terminated by NULL).
+static void _expect(bool json, const char *message, ...) {
+	char *line = _expected[_nbr_of_expected++];
+	va_list args;
+	const char *key;
+
+	if (json) {
+		strcpy(line, "\",\"level\":\"INFO\",\"message\":\"");
+		_append_escaped(line, message);
+		strcat(line, "\"");
+	} else {
+		strcpy(line, "] [INFO] ");
+		strcat(line, message);
+	}
+
+	va_start(args, message);
+
+	while ((key = va_arg(args, const char *)) != NULL) {
+		const char *value = va_arg(args, const char *);
+
+		strcat(line, json ? ",\"" : " ");
+		_append_escaped(line, key);
+		strcat(line, json ? "\":\"" : "=\"");
+		_append_escaped(line, value != NULL ? value : "(null)");
+		strcat(line, "\"");
+	}
+
+	va_end(args);
+	strcat(line, json ? "}\n" : "\n");
+}
+
+/// @brief Write log events with special characters and fields. Each log line must be exactly the expected one.
+static bool _check_log_lines(Logging *log, const char *description) {
+	static char long_text[3000];
+	static char cut_text[LENGTH_LOG_MESSAGE];
+	bool json = log->json_lines;
+
+	remove(LOG_FILE);
+	init_log(log);
+	_nbr_of_expected = 0;
+
+	write_to_log(LOG_INFO, "plain %s number %d", "text", 42);
+	_expect(json, "plain text number 42", NULL);
+
+	// special characters on both sides of the 16 characters, which are checked at once
+	write_to_log(LOG_INFO, "%s", "\"quoted\" back\\slash\nnew line\ttab \x01\x1f end of 16 \"|\" and \x7f");
+	_expect(json, "\"quoted\" back\\slash\nnew line\ttab \x01\x1f end of 16 \"|\" and \x7f", NULL);
+
+	write_to_log(LOG_INFO, "UTF-8: Gr\xc3\xbc\xc3\x9f" "e \xe2\x82\xac");
+	_expect(json, "UTF-8: Gr\xc3\xbc\xc3\x9f" "e \xe2\x82\xac", NULL);
+
+	write_to_log_kv(LOG_INFO, "user logged in", "user", "alice", "id", "17", NULL);
+	_expect(json, "user logged in", "user", "alice", "id", "17", NULL);
+
+	write_to_log_kv(LOG_INFO, "special \"fields\"", "path", "C:\\temp\\new", "note", "line 1\nline 2", "empty", NULL, NULL);
+	_expect(json, "special \"fields\"", "path", "C:\\temp\\new", "note", "line 1\nline 2", "empty", NULL, NULL);
+
+	write_to_log_kv(LOG_INFO, "no fields", NULL);
+	_expect(json, "no fields", NULL);
+
+	// a long log message with fields; the size of a slot is fixed, so it's cut in async mode
+	memset(long_text, '"', sizeof(long_text) - 1);
+	long_text[sizeof(long_text) - 1] = '\0';
+	memcpy(cut_text, long_text, sizeof(cut_text) - 1);
+	cut_text[sizeof(cut_text) - 1] = '\0';
+
+	write_to_log(LOG_INFO, "%s", long_text);
+	_expect(json, log->async_mode ? cut_text : long_text, NULL);
+
+	write_to_log_kv(LOG_INFO, long_text, "key", "value", NULL);
+
+	if (log->async_mode) {
+		// no space is left for the fields
+		_expect(json, cut_text, NULL);
+	} else {
+		_expect(json, long_text, "key", "value", NULL);
+	}
+
+	dispose();
+
+	// the whole log file at once, since a text log message may contain a line break
+	static char content[NBR_OF_EXPECTED * LENGTH_EXPECTED];
+	FILE *file = fopen(LOG_FILE, "rb");
+	size_t length = file != NULL ? fread(content, 1, sizeof(content) - 1, file) : 0;
+	bool valid = file != NULL;
+	content[length] = '\0';
+
+	if (file != NULL) {
+		fclose(file);
+	}
+
+	// "{"time":"YYYY-MM-DD HH:MM:SS", ..." or "[YYYY-MM-DD HH:MM:SS] [INFO] ..."
+	const char *start = json ? "{\"time\":\"" : "[";
+	const char *line = content;
+	int i = 0;
+
+	for (; valid && i < _nbr_of_expected && *line != '\0'; i++) {
+		const char *rest = line + strlen(start) + LENGTH_TIMESTAMP_IN_LINE;
+		size_t expected_length = strlen(_expected[i]);
+
+		if (
+			strlen(line) < strlen(start) + LENGTH_TIMESTAMP_IN_LINE || strncmp(line, start, strlen(start)) != 0 ||
+			strncmp(rest, _expected[i], expected_length) != 0
+		) {
+			fprintf(stderr, "written: %.160s\nexpected: %.160s\n", line, _expected[i]);
+			valid = false;
+		}
+
+		line = rest + expected_length;
+	}
+
+	valid = valid && *line == '\0';
+	valid = valid && i == _nbr_of_expected;
+	printf("%-22s %d log lines: %s\n", description, i, valid ? "passed" : "FAILED");
+	return valid;
+}
+
+/// @brief Compare the time for LINES_FOR_SPEED log events as text and as JSON.
+static void _compare_speed(Logging *log) {
+	for (int json = 0; json <= 1; json++) {
+		log->json_lines = json;
+		remove(LOG_FILE);
+		init_log(log);
+
+		double start = _now_in_seconds();
+
+		for (int i = 0; i < LINES_FOR_SPEED; i++) {
+			write_to_log(LOG_INFO, "line %06d of %s with a \"quoted\" word and %.2f%% done", i, "writer", 100.0 * i / LINES_FOR_SPEED);
+		}
+
+		dispose();
+		double elapsed = _now_in_seconds() - start;
+		printf("%-22s %d lines: %.3f s (%.0f lines/s)\n", json ? "JSON lines:" : "text:", LINES_FOR_SPEED, elapsed, LINES_FOR_SPEED / elapsed);
+	}
+}
+
+int main(void) {
+	// Create a new log construction.
+	// NOTE: With json_lines each log event is written as JSON object, e.g. for a log pipeline:
+	//       {"time":"2026-10-16 12:34:56","level":"INFO","message":"user logged in","user":"alice","id":"17"}
+	//       The fields come from write_to_log_kv(). Without json_lines they are written as: user="alice" id="17"
+	Logging log = {
+		.on_console_only = false,
+		.init_level = LOG_INFO,
+		.file_name = LOG_FILE,
+		.rotation_setting = NO_ROTATION,
+		.keep_file_open = true,
+		.json_lines = false
+	};
+
+	bool valid = _check_log_lines(&log, "text:");
+
+	log.json_lines = true;
+	valid = _check_log_lines(&log, "JSON lines:") && valid;
+
+	log.batch_mode = true;
+	valid = _check_log_lines(&log, "JSON lines, batch mode:") && valid;
+
+	log.batch_mode = false;
+	log.async_mode = true;
+	valid = _check_log_lines(&log, "JSON lines, async mode:") && valid;
+
+	log.async_mode = false;
+	_compare_speed(&log);
+
+	remove(LOG_FILE);
+	return valid ? EXIT_SUCCESS : EXIT_FAILURE;
+}
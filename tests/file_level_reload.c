@@ -0,0 +1,301 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include <stdatomic.h>
+#include "logging.h"
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <pthread.h>
+#include <signal.h>
+#endif
+
+#define LOG_FILE          "level_reload.log"
+#define CONFIG_FILE       "level_reload.conf"
+#define NBR_OF_THREADS    4
+#define LINES_PER_THREAD  20000
+#define CHECK_INTERVAL    20
+
+/// @brief Returns the current wall clock time in seconds.
+static double _now_in_seconds(void) {
+	struct timespec ts;
+	timespec_get(&ts, TIME_UTC);
+	return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+/// @brief Write a config file.
+static void _write_config_file(const char *content) {
+	FILE *file = fopen(CONFIG_FILE, "w");
+
+	if (file != NULL) {
+		fputs(content, file);
+		fclose(file);
+	}
+}
+
+/// @brief Count the log lines in the log file, which contain the given text.
+static int _count_log_lines(const char *text) {
+	FILE *file = fopen(LOG_FILE, "r");
+	char buffer[512];
+	int count = 0;
+
+	while (file != NULL && fgets(buffer, sizeof(buffer), file) != NULL) {
+		count += strstr(buffer, text) != NULL;
+	}
+
+	if (file != NULL) {
+		fclose(file);
+	}
+
+	return count;
+}
+
+/// @brief Wait up to the given time, until the log level has been changed to the expected one.
+/// @return the time in ms until the change or -1
+static int _wait_for_level(LogLevel expected, int timeout_in_ms) {
+	double start = _now_in_seconds();
+	double end = start + timeout_in_ms / 1000.0;
+
+	while (get_log_level() != expected) {
+		if (_now_in_seconds() >= end) {
+			return -1;
+		}
+	}
+
+	return (int)((_now_in_seconds() - start) * 1000);
+}
+
+/// @brief A callsite of a parser, which is limited by "callsite file_level_reload.c = ..."
+static void _parser_callsite(LogLevel level, int value) {
+	switch (level) {
+		case LOG_DEBUG:
+			LOG_CALLSITE_(LOG_DEBUG, "parser debug %d", value);
+			break;
+		case LOG_WARNING:
+			LOG_CALLSITE_(LOG_WARNING, "parser warning %d", value);
+			break;
+		default:
+			break;
+	}
+}
+
+/// @brief set_log_level() changes the log level at once, the log file is kept.
+static bool _check_set_log_level(Logging *log) {
+	remove(LOG_FILE);
+	init_log(log);
+
+	LOG_DEBUG_("debug %d", 1);
+	set_log_level(LOG_DEBUG);
+	LogLevel changed = get_log_level();
+	LOG_DEBUG_("debug %d", 2);
+	set_log_level(LOG_ERROR);
+	LOG_WARNING_("warning %d", 1);
+
+	// an invalid log level is ignored
+	set_log_level((LogLevel)42);
+	LogLevel kept = get_log_level();
+	LOG_ERROR_("error %d", 1);
+	dispose();
+
+	bool valid = changed == LOG_DEBUG && kept == LOG_ERROR && _count_log_lines("] [DEBUG] debug 1") == 0 &&
+		_count_log_lines("] [DEBUG] debug 2") == 1 && _count_log_lines("] [WARN] warning 1") == 0 &&
+		_count_log_lines("] [ERROR] error 1") == 1;
+
+	printf("%-22s %s\n", "set_log_level():", valid ? "passed" : "FAILED");
+	return valid;
+}
+
+/// @brief reload_log_config() sets the log level and a threshold for the callsites of a source file.
+static bool _check_reload_log_config(Logging *log) {
+	remove(LOG_FILE);
+	init_log(log);
+
+	_write_config_file(
+		"# log level and callsites\n"
+		"level = debug\n"
+		"callsite file_level_reload.c = WARNING   # only warnings of this file\n"
+	);
+
+	bool applied = reload_log_config(CONFIG_FILE);
+	LogLevel level = get_log_level();
+	_parser_callsite(LOG_DEBUG, 1);
+	_parser_callsite(LOG_WARNING, 1);
+
+	// an invalid line is ignored, the valid lines are applied anyway
+	_write_config_file("level = loud\ncallsite file_level_reload.c = on\n");
+	bool invalid = reload_log_config(CONFIG_FILE);
+	_parser_callsite(LOG_DEBUG, 2);
+	bool missing = reload_log_config("missing_" CONFIG_FILE);
+	dispose();
+
+	bool valid = applied && !invalid && !missing && level == LOG_DEBUG && _count_log_lines("parser debug 1") == 0 &&
+		_count_log_lines("parser warning 1") == 1 && _count_log_lines("parser debug 2") == 1;
+
+	printf("%-22s %s\n", "reload_log_config():", valid ? "passed" : "FAILED");
+	return valid;
+}
+
+/// @brief A changed config file is reloaded by the background thread within its interval.
+static bool _check_config_file(Logging *log) {
+	_write_config_file("level = WARN\n");
+	remove(LOG_FILE);
+
+	snprintf(log->config_file, sizeof(log->config_file), "%s", CONFIG_FILE);
+	log->config_check_interval_in_ms = CHECK_INTERVAL;
+	init_log(log);
+
+	// the config file is read while initializing
+	LogLevel initial = get_log_level();
+	_write_config_file("level = TRACE # more details\n");
+	int reloaded_in_ms = _wait_for_level(LOG_TRACE, 3000);
+	LOG_TRACE_("trace %d", 1);
+	dispose();
+
+	bool valid = initial == LOG_WARNING && reloaded_in_ms >= 0 && _count_log_lines("] [TRACE] trace 1") == 1;
+	printf("%-22s reloaded in %d ms: %s\n", "config file:", reloaded_in_ms, valid ? "passed" : "FAILED");
+	return valid;
+}
+
+#ifndef _WIN32
+static atomic_int _application_sighups;
+
+/// @brief Handler of SIGHUP by the application itself.
+static void _on_application_sighup(int signal_number) {
+	(void)signal_number;
+	atomic_fetch_add(&_application_sighups, 1);
+}
+
+/// @brief SIGHUP reloads the config file, even if it hasn't been changed and the interval is long. The handler of the
+///        application is restored by dispose().
+static bool _check_sighup(Logging *log) {
+	_write_config_file("level = ERROR\n");
+	remove(LOG_FILE);
+
+	struct sigaction application = {0};
+	application.sa_handler = _on_application_sighup;
+	sigemptyset(&application.sa_mask);
+	sigaction(SIGHUP, &application, NULL);
+
+	snprintf(log->config_file, sizeof(log->config_file), "%s", CONFIG_FILE);
+	log->config_check_interval_in_ms = 60000;
+	log->reload_on_sighup = true;
+	init_log(log);
+
+	set_log_level(LOG_INFO);
+	raise(SIGHUP);
+	int reloaded_in_ms = _wait_for_level(LOG_ERROR, 3000);
+	bool taken_over = atomic_load(&_application_sighups) == 0;
+	dispose();
+
+	struct sigaction restored;
+	sigaction(SIGHUP, NULL, &restored);
+	raise(SIGHUP);
+
+	bool valid = reloaded_in_ms >= 0 && taken_over && restored.sa_handler == _on_application_sighup &&
+		atomic_load(&_application_sighups) == 1;
+	printf("%-22s reloaded in %d ms: %s\n", "SIGHUP:", reloaded_in_ms, valid ? "passed" : "FAILED");
+	return valid;
+}
+#endif
+
+/// @brief Writes LINES_PER_THREAD INFO log events, while the main thread changes the log level.
+#ifdef _WIN32
+static DWORD WINAPI _writer(LPVOID argument) {
+#else
+static void *_writer(void *argument) {
+#endif
+	int thread_id = (int)(size_t)argument;
+
+	for (int i = 0; i < LINES_PER_THREAD; i++) {
+		LOG_INFO_("thread %d line %d", thread_id, i);
+		LOG_DEBUG_("thread %d debug %d", thread_id, i);
+	}
+
+	return 0;
+}
+
+/// @brief The log level is changed by another thread without any lock. Each INFO log event must be written.
+static bool _check_concurrent_changes(Logging *log) {
+	remove(LOG_FILE);
+	init_log(log);
+
+	#ifdef _WIN32
+	HANDLE threads[NBR_OF_THREADS];
+
+	for (int i = 0; i < NBR_OF_THREADS; i++) {
+		threads[i] = CreateThread(NULL, 0, _writer, (LPVOID)(size_t)i, 0, NULL);
+	}
+	#else
+	pthread_t threads[NBR_OF_THREADS];
+
+	for (int i = 0; i < NBR_OF_THREADS; i++) {
+		pthread_create(&threads[i], NULL, _writer, (void *)(size_t)i);
+	}
+	#endif
+
+	int changes = 0;
+
+	for (; changes < 10000; changes++) {
+		set_log_level(changes % 2 == 0 ? LOG_DEBUG : LOG_INFO);
+	}
+
+	#ifdef _WIN32
+	WaitForMultipleObjects(NBR_OF_THREADS, threads, TRUE, INFINITE);
+
+	for (int i = 0; i < NBR_OF_THREADS; i++) {
+		CloseHandle(threads[i]);
+	}
+	#else
+	for (int i = 0; i < NBR_OF_THREADS; i++) {
+		pthread_join(threads[i], NULL);
+	}
+	#endif
+
+	dispose();
+
+	int info_lines = _count_log_lines("] [INFO] thread ");
+	bool valid = info_lines == NBR_OF_THREADS * LINES_PER_THREAD;
+	printf(
+		"%-22s %d of %d INFO log events with %d level changes: %s\n",
+		"concurrent changes:", info_lines, NBR_OF_THREADS * LINES_PER_THREAD, changes, valid ? "passed" : "FAILED"
+	);
+
+	return valid;
+}
+
+int main(void) {
+	// Create a new log construction.
+	// NOTE: set_log_level() changes the log level at runtime without a new init_log(). With config_file a background
+	//       thread reloads the log level and the callsite rules, whenever the config file has been changed:
+	//       level = DEBUG
+	//       callsite parser.c = WARN
+	//       With reload_on_sighup the config file is reloaded by "kill -HUP <pid>", too.
+	Logging log = {
+		.on_console_only = false,
+		.init_level = LOG_INFO,
+		.file_name = LOG_FILE,
+		.rotation_setting = NO_ROTATION,
+		.keep_file_open = true
+	};
+
+	bool valid = _check_set_log_level(&log);
+	valid = _check_reload_log_config(&log) && valid;
+	valid = _check_concurrent_changes(&log) && valid;
+
+	log.async_mode = true;
+	valid = _check_concurrent_changes(&log) && valid;
+
+	log.async_mode = false;
+	valid = _check_config_file(&log) && valid;
+
+	#ifndef _WIN32
+	valid = _check_sighup(&log) && valid;
+	#endif
+
+	remove(CONFIG_FILE);
+	remove(LOG_FILE);
+	return valid ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,164 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include "logging.h"
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <pthread.h>
+#endif
+
+#define NBR_OF_THREADS    8
+#define LINES_PER_THREAD  50000
+#define KEEPING_FILES     100
+#define LOG_FILE          "mapped.log"
+
+/// @brief Returns the current wall clock time in seconds.
+static double _now_in_seconds(void) {
+	struct timespec ts;
+	timespec_get(&ts, TIME_UTC);
+	return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+/// @brief Every thread writes LINES_PER_THREAD numbered log events.
+#ifdef _WIN32
+static DWORD WINAPI _writer(LPVOID argument) {
+#else
+static void *_writer(void *argument) {
+#endif
+	int thread_id = (int)(size_t)argument;
+
+	for (int line = 0; line < LINES_PER_THREAD; line++) {
+		write_to_log(LOG_INFO, "thread %02d line %06d payload-%s", thread_id, line, "0123456789abcdefghijklmnopqrstuvwxyz");
+	}
+
+	return 0;
+}
+
+/// @brief Start NBR_OF_THREADS threads, which are writing at the same time, and wait for them.
+static void _run_writers(void) {
+	#ifdef _WIN32
+	HANDLE threads[NBR_OF_THREADS];
+
+	for (int i = 0; i < NBR_OF_THREADS; i++) {
+		threads[i] = CreateThread(NULL, 0, _writer, (LPVOID)(size_t)i, 0, NULL);
+	}
+
+	WaitForMultipleObjects(NBR_OF_THREADS, threads, TRUE, INFINITE);
+
+	for (int i = 0; i < NBR_OF_THREADS; i++) {
+		CloseHandle(threads[i]);
+	}
+	#else
+	pthread_t threads[NBR_OF_THREADS];
+
+	for (int i = 0; i < NBR_OF_THREADS; i++) {
+		pthread_create(&threads[i], NULL, _writer, (void *)(size_t)i);
+	}
+
+	for (int i = 0; i < NBR_OF_THREADS; i++) {
+		pthread_join(threads[i], NULL);
+	}
+	#endif
+}
+
+/// @brief Read a log file and count the lines of each thread. Every line must be complete
+///        and no '\0' character may be left from the mapping.
+/// @return true, if the log file is valid or doesn't exist, otherwise false
+static bool _verify_log_file(const char *file_name, int *lines_of_thread) {
+	FILE *file = fopen(file_name, "rb");
+
+	if (file == NULL) {
+		return true;
+	}
+
+	char buffer[512];
+	bool valid = true;
+
+	while (fgets(buffer, sizeof(buffer), file) != NULL) {
+		int thread_id = -1;
+		int line = -1;
+		char payload[64] = {0};
+		char end = '\0';
+
+		// "[YYYY-MM-DD HH:MM:SS] [INFO] thread xx line yyyyyy payload-..."
+		int matched = sscanf(buffer, "[%*19c] [INFO] thread %d line %d payload-%63s%c", &thread_id, &line, payload, &end);
+
+		if (
+			matched != 4 || end != '\n' || thread_id < 0 || thread_id >= NBR_OF_THREADS ||
+			strcmp(payload, "0123456789abcdefghijklmnopqrstuvwxyz") != 0
+		) {
+			fprintf(stderr, "%s: torn line: %s\n", file_name, buffer);
+			valid = false;
+			continue;
+		}
+
+		lines_of_thread[thread_id]++;
+	}
+
+	fclose(file);
+	return valid;
+}
+
+/// @brief Remove the log file and every rotated file.
+static void _remove_log_files(void) {
+	char name[64];
+	remove(LOG_FILE);
+
+	for (int i = 0; i < KEEPING_FILES; i++) {
+		snprintf(name, sizeof(name), "%s.%06d", LOG_FILE, i);
+		remove(name);
+	}
+}
+
+int main(void) {
+	// Create a new log construction.
+	// NOTE: With memory_mapped_files the log file is mapped into the memory and every thread copies
+	//       its log line into it without a lock. Until the next rotation the rest of the log file
+	//       is filled with '\0' characters, afterwards the log file is cut to its real length.
+	Logging log = {
+		.on_console_only = false,
+		.init_level = LOG_INFO,
+		.file_name = LOG_FILE,
+		.rotation_setting = SIZE_ROTATION,
+		.rotation_naming = NAMING_SEQUENCE,
+		.nbr_of_keeping_files = KEEPING_FILES,
+		.file_size_in_mb = 1,
+		.memory_mapped_files = true
+	};
+
+	_remove_log_files();
+	init_log(&log);
+
+	double start = _now_in_seconds();
+	_run_writers();
+	dispose();
+	double elapsed = _now_in_seconds() - start;
+
+	int lines_of_thread[NBR_OF_THREADS] = {0};
+	bool valid = _verify_log_file(LOG_FILE, lines_of_thread);
+	char name[64];
+
+	for (int i = 0; i < KEEPING_FILES; i++) {
+		snprintf(name, sizeof(name), "%s.%06d", LOG_FILE, i);
+		valid = _verify_log_file(name, lines_of_thread) && valid;
+	}
+
+	for (int i = 0; i < NBR_OF_THREADS; i++) {
+		if (lines_of_thread[i] != LINES_PER_THREAD) {
+			fprintf(stderr, "thread %d: %d of %d lines found\n", i, lines_of_thread[i], LINES_PER_THREAD);
+			valid = false;
+		}
+	}
+
+	printf(
+		"memory mapped: %d threads x %d lines: %.3f s (%.0f lines/s): %s\n",
+		NBR_OF_THREADS, LINES_PER_THREAD, elapsed, NBR_OF_THREADS * LINES_PER_THREAD / elapsed, valid ? "passed" : "FAILED"
+	);
+
+	_remove_log_files();
+	return valid ? EXIT_SUCCESS : EXIT_FAILURE;
+}
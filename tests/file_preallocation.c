@@ -0,0 +1,58 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <sys/stat.h>
+#include "logging.h"
+
+#define LOG_FILE         "preallocated.log"
+#define LOG_MESSAGE      "This is a simple message."
+
+/// @brief Returns the disk space of a file in bytes or -1, if it's unknown on this system.
+static long long _disk_space(const char *file_name) {
+	#ifdef _WIN32
+	(void)file_name;
+	return -1;
+	#else
+	struct stat st;
+	return stat(file_name, &st) == 0 ? (long long)st.st_blocks * 512LL : -1;
+	#endif
+}
+
+int main(void) {
+	// Create a new log construction.
+	// NOTE: With preallocate_files each new log file reserves file_size_in_mb on the disk at once.
+	//       The file size stays the real length of the log file, so it's appended as usual.
+	//       The unused space is released by a rotation or by dispose().
+	Logging log = {
+		.on_console_only = false,
+		.init_level = LOG_INFO,
+		.file_name = LOG_FILE,
+		.rotation_setting = SIZE_ROTATION,
+		.nbr_of_keeping_files = 3,
+		.file_size_in_mb = 4,
+		.keep_file_open = true,
+		.preallocate_files = true
+	};
+
+	remove(LOG_FILE);
+	init_log(&log);
+
+	for (int i = 0; i < 1000; i++) {
+		write_to_log(LOG_INFO, "%s (%d)", LOG_MESSAGE, i);
+	}
+
+	long long reserved = _disk_space(LOG_FILE);
+	dispose();
+	long long released = _disk_space(LOG_FILE);
+
+	// a file system without preallocation keeps both values small
+	printf("disk space while logging: %lld bytes, after dispose(): %lld bytes\n", reserved, released);
+	bool valid = released <= reserved && released < 1024 * 1024;
+	printf("preallocation: %s\n", valid ? "passed" : "FAILED");
+
+	remove(LOG_FILE);
+	remove(LOG_FILE ".1");
+	remove(LOG_FILE ".2");
+	return valid ? EXIT_SUCCESS : EXIT_FAILURE;
+}
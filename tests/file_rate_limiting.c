@@ -0,0 +1,247 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include "logging.h"
+
+#define LOG_FILE          "rate_limiting.log"
+#define SAMPLED_CALLS     1000
+#define SAMPLING_RATE     100
+#define DEBUG_PER_SECOND  100
+#define DEBUG_EVENTS      100000
+#define REPORT_INTERVAL   50
+
+/// @brief Number of log lines of each kind in the log file.
+typedef struct {
+	unsigned long long debug_lines;
+	unsigned long long info_lines;
+	unsigned long long report_lines;
+	unsigned long long reported_events;
+} LogFileContent;
+
+/// @brief Number of evaluated arguments of LOG_SAMPLED_() and of its sampling rate.
+static int _evaluated = 0;
+static int _rate_evaluated = 0;
+
+/// @brief Returns the current wall clock time in seconds.
+static double _now_in_seconds(void) {
+	struct timespec ts;
+	timespec_get(&ts, TIME_UTC);
+	return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+/// @brief Count the log lines and add up the suppressed log events of every report in the log file.
+static LogFileContent _read_log_file(void) {
+	LogFileContent content = {0};
+	FILE *file = fopen(LOG_FILE, "r");
+	char buffer[512];
+
+	while (file != NULL && fgets(buffer, sizeof(buffer), file) != NULL) {
+		unsigned long long count = 0;
+		const char *report = strstr(buffer, "] [WARN] suppressed ");
+
+		if (strstr(buffer, "] [DEBUG] ") != NULL) {
+			content.debug_lines++;
+		} else if (strstr(buffer, "] [INFO] ") != NULL) {
+			content.info_lines++;
+		} else if (report != NULL && sscanf(report + 20, "%llu log events by sampling or rate limits:", &count) == 1) {
+			content.report_lines++;
+			content.reported_events += count;
+		}
+	}
+
+	if (file != NULL) {
+		fclose(file);
+	}
+
+	return content;
+}
+
+/// @brief Only the first of every SAMPLING_RATE calls of a callsite is logged and evaluates its arguments.
+static bool _check_sampling(Logging *log) {
+	remove(LOG_FILE);
+	init_log(log);
+	_evaluated = 0;
+	_rate_evaluated = 0;
+
+	for (int i = 0; i < SAMPLED_CALLS; i++) {
+		LOG_SAMPLED_(LOG_DEBUG, (++_rate_evaluated, SAMPLING_RATE), "sampled call %d of %d", i, ++_evaluated);
+		LOG_SAMPLED_(LOG_TRACE, (++_rate_evaluated, SAMPLING_RATE), "not handled %d", ++_evaluated);
+	}
+
+	// the skipped calls behind the last logged one aren't counted yet
+	unsigned long long suppressed = get_suppressed_log_events();
+	dispose();
+
+	LogFileContent content = _read_log_file();
+	unsigned long long expected = (SAMPLED_CALLS / SAMPLING_RATE - 1) * (SAMPLING_RATE - 1);
+	// the sampling rate is evaluated once for each handled call, never for a level, which isn't handled
+	bool valid = content.debug_lines == SAMPLED_CALLS / SAMPLING_RATE && _evaluated == SAMPLED_CALLS / SAMPLING_RATE &&
+		_rate_evaluated == SAMPLED_CALLS &&
+		suppressed == expected && content.report_lines == 1 && content.reported_events == expected;
+
+	printf(
+		"%-22s %llu of %d calls logged, %llu suppressed: %s\n",
+		"sampling:", content.debug_lines, SAMPLED_CALLS, suppressed, valid ? "passed" : "FAILED"
+	);
+
+	return valid;
+}
+
+/// @brief DEBUG_EVENTS DEBUG log events are limited to DEBUG_PER_SECOND, the INFO log events aren't limited at all.
+///        Every suppressed log event must be reported.
+static bool _check_rate_limit(Logging *log, const char *description) {
+	remove(LOG_FILE);
+	init_log(log);
+
+	double start = _now_in_seconds();
+
+	for (int i = 0; i < DEBUG_EVENTS; i++) {
+		write_to_log(LOG_DEBUG, "debug %d", i);
+
+		if (i % 1000 == 0) {
+			write_to_log_kv(LOG_INFO, "progress", "step", "1000", NULL);
+		}
+	}
+
+	double elapsed = _now_in_seconds() - start;
+	unsigned long long suppressed = get_suppressed_log_events();
+	dispose();
+
+	// the bucket is full at first, afterwards one log event each 1/DEBUG_PER_SECOND s
+	LogFileContent content = _read_log_file();
+	unsigned long long allowed = DEBUG_PER_SECOND + (unsigned long long)(elapsed * DEBUG_PER_SECOND) + 1;
+	bool valid = content.debug_lines >= DEBUG_PER_SECOND && content.debug_lines <= allowed &&
+		content.debug_lines + suppressed == DEBUG_EVENTS && content.info_lines == DEBUG_EVENTS / 1000 &&
+		content.reported_events == suppressed;
+
+	printf(
+		"%-22s %llu of %d DEBUG log events in %.3f s, %llu reports: %s\n",
+		description, content.debug_lines, DEBUG_EVENTS, elapsed, content.report_lines, valid ? "passed" : "FAILED"
+	);
+
+	return valid;
+}
+
+/// @brief While DEBUG log events are suppressed, a report is written each REPORT_INTERVAL ms.
+static bool _check_periodic_reports(Logging *log) {
+	remove(LOG_FILE);
+	init_log(log);
+
+	double end = _now_in_seconds() + REPORT_INTERVAL * 5 / 1000.0;
+
+	while (_now_in_seconds() < end) {
+		write_to_log(LOG_DEBUG, "busy");
+	}
+
+	dispose();
+
+	// about one report each REPORT_INTERVAL ms and the last one by dispose()
+	LogFileContent content = _read_log_file();
+	bool valid = content.report_lines >= 4 && content.report_lines <= 7;
+	printf("%-22s %llu reports: %s\n", "periodic reports:", content.report_lines, valid ? "passed" : "FAILED");
+	return valid;
+}
+
+/// @brief Count the log lines in the log file, which contain the given text.
+static int _count_log_lines(const char *text) {
+	FILE *file = fopen(LOG_FILE, "r");
+	char buffer[512];
+	int count = 0;
+
+	while (file != NULL && fgets(buffer, sizeof(buffer), file) != NULL) {
+		count += strstr(buffer, text) != NULL;
+	}
+
+	if (file != NULL) {
+		fclose(file);
+	}
+
+	return count;
+}
+
+/// @brief Above LOG_WARNING the report is still written at LOG_WARNING. It isn't an error, so it doesn't write the log
+///        events, which are kept by the flight recorder.
+static bool _check_report_above_warning(Logging *log) {
+	Logging settings = *log;
+	settings.init_level = LOG_ERROR;
+	settings.rate_limits[LOG_ERROR] = 1;
+	settings.flight_recorder = true;
+	settings.flight_recorder_level = LOG_DEBUG;
+
+	remove(LOG_FILE);
+	init_log(&settings);
+
+	write_to_log(LOG_DEBUG, "kept before the error");
+	write_to_log(LOG_ERROR, "first error");
+
+	for (int i = 0; i < 10; i++) {
+		write_to_log(LOG_ERROR, "suppressed error %d", i);
+	}
+
+	write_to_log(LOG_DEBUG, "kept after the error");
+	dispose();
+
+	bool valid = _count_log_lines("] [WARN] suppressed 10 log events") == 1 && _count_log_lines("] [ERROR] suppressed") == 0 &&
+		_count_log_lines("kept before the error") == 1 && _count_log_lines("kept after the error") == 0;
+
+	printf("%-22s %s\n", "report above WARNING:", valid ? "passed" : "FAILED");
+	return valid;
+}
+
+/// @brief Compare the time of a DEBUG log event, which is written, with one, which is suppressed by the rate limit.
+static void _compare_speed(Logging *log) {
+	for (int limited = 0; limited <= 1; limited++) {
+		log->rate_limits[LOG_DEBUG] = limited ? 1 : 0;
+		remove(LOG_FILE);
+		init_log(log);
+
+		double start = _now_in_seconds();
+
+		for (int i = 0; i < DEBUG_EVENTS; i++) {
+			write_to_log(LOG_DEBUG, "line %06d of %s with %.2f%% done", i, "writer", 100.0 * i / DEBUG_EVENTS);
+		}
+
+		double elapsed = _now_in_seconds() - start;
+		dispose();
+		printf(
+			"%-22s %d log events: %.3f s (%.0f ns each)\n",
+			limited ? "rate limited:" : "written:", DEBUG_EVENTS, elapsed, elapsed * 1e9 / DEBUG_EVENTS
+		);
+	}
+}
+
+int main(void) {
+	// Create a new log construction.
+	// NOTE: With rate_limits each level gets a maximal number of log events per second. LOG_SAMPLED_() logs only
+	//       the first of every n calls of its callsite. In both cases a suppressed log event isn't formatted at all,
+	//       it's only counted and reported each suppression_report_interval_in_ms:
+	//       "suppressed 1234 log events by sampling or rate limits: DEBUG 1234"
+	Logging log = {
+		.on_console_only = false,
+		.init_level = LOG_DEBUG,
+		.file_name = LOG_FILE,
+		.rotation_setting = NO_ROTATION,
+		.keep_file_open = true
+	};
+
+	bool valid = _check_sampling(&log);
+
+	log.rate_limits[LOG_DEBUG] = DEBUG_PER_SECOND;
+	valid = _check_rate_limit(&log, "caller's thread:") && valid;
+
+	log.async_mode = true;
+	valid = _check_rate_limit(&log, "async mode:") && valid;
+
+	log.async_mode = false;
+	log.suppression_report_interval_in_ms = REPORT_INTERVAL;
+	valid = _check_periodic_reports(&log) && valid;
+	valid = _check_report_above_warning(&log) && valid;
+
+	log.suppression_report_interval_in_ms = 0;
+	_compare_speed(&log);
+
+	remove(LOG_FILE);
+	return valid ? EXIT_SUCCESS : EXIT_FAILURE;
+}
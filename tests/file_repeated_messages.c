@@ -0,0 +1,205 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include "logging.h"
+
+#define LOG_FILE          "repeated.log"
+#define WINDOW_IN_MS      100
+#define LINES_FOR_SPEED   200000
+
+/// @brief Returns the current wall clock time in seconds.
+static double _now_in_seconds(void) {
+	struct timespec ts;
+	timespec_get(&ts, TIME_UTC);
+	return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+/// @brief Wait for the given time without any further log event.
+static void _wait_for_ms(int ms) {
+	double end = _now_in_seconds() + ms / 1000.0;
+
+	while (_now_in_seconds() < end) {
+	}
+}
+
+/// @brief Compare the log file with the expected log lines without their timestamps, e.g. "[INFO] message".
+/// @param expected the expected log lines, terminated by NULL
+static bool _verify_log_file(const char *description, const char **expected) {
+	FILE *file = fopen(LOG_FILE, "r");
+	char buffer[512];
+	bool valid = file != NULL;
+	int i = 0;
+
+	while (valid && fgets(buffer, sizeof(buffer), file) != NULL) {
+		// "[YYYY-MM-DD HH:MM:SS] [LEVEL] message"
+		char *line = strstr(buffer, "] [");
+		buffer[strcspn(buffer, "\n")] = '\0';
+
+		if (line == NULL || expected[i] == NULL || strcmp(line + 2, expected[i]) != 0) {
+			fprintf(stderr, "written: %s\nexpected: %s\n", buffer, expected[i] != NULL ? expected[i] : "nothing");
+			valid = false;
+		}
+
+		i++;
+	}
+
+	if (file != NULL) {
+		fclose(file);
+	}
+
+	valid = valid && expected[i] == NULL;
+	printf("%-26s %s\n", description, valid ? "passed" : "FAILED");
+	return valid;
+}
+
+/// @brief Repeated log messages are counted and summarized by the next different log message or by dispose().
+static bool _check_repetitions(Logging *log, const char *description) {
+	remove(LOG_FILE);
+	init_log(log);
+
+	for (int i = 0; i < 1000; i++) {
+		write_to_log(LOG_WARNING, "retry %d failed", 1);
+	}
+
+	write_to_log(LOG_WARNING, "retry %d failed", 2);
+
+	// the same log message with another level isn't a repetition
+	write_to_log(LOG_ERROR, "retry %d failed", 2);
+	write_to_log(LOG_ERROR, "retry %d failed", 2);
+
+	// the fields are a part of the log message
+	write_to_log_kv(LOG_INFO, "request", "status", "503", NULL);
+	write_to_log_kv(LOG_INFO, "request", "status", "503", NULL);
+	write_to_log_kv(LOG_INFO, "request", "status", "503", NULL);
+	write_to_log_kv(LOG_INFO, "request", "status", "200", NULL);
+
+	for (int i = 0; i < 5; i++) {
+		write_to_log(LOG_INFO, "shutting down");
+	}
+
+	dispose();
+
+	const char *expected[] = {
+		"[WARN] retry 1 failed",
+		"[WARN] last message repeated 999 times",
+		"[WARN] retry 2 failed",
+		"[ERROR] retry 2 failed",
+		"[ERROR] last message repeated 1 time",
+		"[INFO] request status=\"503\"",
+		"[INFO] last message repeated 2 times",
+		"[INFO] request status=\"200\"",
+		"[INFO] shutting down",
+		"[INFO] last message repeated 4 times",
+		NULL
+	};
+
+	return _verify_log_file(description, expected);
+}
+
+/// @brief A repetition after the window writes the summary and the log message again.
+static bool _check_window(Logging *log, const char *description) {
+	remove(LOG_FILE);
+	init_log(log);
+
+	write_to_log(LOG_INFO, "storm");
+	write_to_log(LOG_INFO, "storm");
+	write_to_log(LOG_INFO, "storm");
+	_wait_for_ms(WINDOW_IN_MS * 2);
+	write_to_log(LOG_INFO, "storm");
+	write_to_log(LOG_INFO, "storm");
+	dispose();
+
+	const char *expected[] = {
+		"[INFO] storm",
+		"[INFO] last message repeated 2 times",
+		"[INFO] storm",
+		"[INFO] last message repeated 1 time",
+		NULL
+	};
+
+	return _verify_log_file(description, expected);
+}
+
+/// @brief In async mode the background writer writes the summary after the window, even without a further log event.
+static bool _check_idle_summary(Logging *log, const char *description) {
+	remove(LOG_FILE);
+	init_log(log);
+
+	write_to_log(LOG_INFO, "idle");
+	write_to_log(LOG_INFO, "idle");
+	write_to_log(LOG_INFO, "idle");
+	_wait_for_ms(WINDOW_IN_MS * 3);
+
+	const char *expected[] = {
+		"[INFO] idle",
+		"[INFO] last message repeated 2 times",
+		NULL
+	};
+
+	// the log file is checked before dispose()
+	bool valid = _verify_log_file(description, expected);
+	dispose();
+	return valid;
+}
+
+/// @brief Compare the time for LINES_FOR_SPEED repeated log messages with and without the suppression.
+static void _compare_speed(Logging *log) {
+	for (int suppress = 0; suppress <= 1; suppress++) {
+		log->suppress_repeated_messages = suppress;
+		remove(LOG_FILE);
+		init_log(log);
+
+		double start = _now_in_seconds();
+
+		for (int i = 0; i < LINES_FOR_SPEED; i++) {
+			write_to_log(LOG_WARNING, "connection to %s:%d refused, retrying", "database", 5432);
+		}
+
+		dispose();
+		double elapsed = _now_in_seconds() - start;
+		printf(
+			"%-26s %d lines: %.3f s (%.0f lines/s)\n",
+			suppress ? "suppressed repetitions:" : "every repetition:", LINES_FOR_SPEED, elapsed, LINES_FOR_SPEED / elapsed
+		);
+	}
+}
+
+int main(void) {
+	// Create a new log construction.
+	// NOTE: With suppress_repeated_messages a log message, which is the same as the previous one, is only counted.
+	//       The next different log message, dispose() or the end of repeat_window_in_ms writes the summary:
+	//       "last message repeated N times"
+	Logging log = {
+		.on_console_only = false,
+		.init_level = LOG_INFO,
+		.file_name = LOG_FILE,
+		.rotation_setting = NO_ROTATION,
+		.keep_file_open = true,
+		.suppress_repeated_messages = true,
+		.repeat_window_in_ms = WINDOW_IN_MS
+	};
+
+	bool valid = _check_repetitions(&log, "caller's thread:");
+	valid = _check_window(&log, "caller's thread, window:") && valid;
+
+	log.keep_file_open = false;
+	valid = _check_repetitions(&log, "open/close:") && valid;
+
+	log.keep_file_open = true;
+	log.batch_mode = true;
+	valid = _check_repetitions(&log, "batch mode:") && valid;
+
+	log.batch_mode = false;
+	log.async_mode = true;
+	valid = _check_repetitions(&log, "async mode:") && valid;
+	valid = _check_window(&log, "async mode, window:") && valid;
+	valid = _check_idle_summary(&log, "async mode, idle summary:") && valid;
+
+	log.async_mode = false;
+	_compare_speed(&log);
+
+	remove(LOG_FILE);
+	return valid ? EXIT_SUCCESS : EXIT_FAILURE;
+}
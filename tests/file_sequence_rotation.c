@@ -0,0 +1,121 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include "logging.h"
+
+#define LOG_FILE         "sequence.log"
+#define KEEPING_FILES    100
+#define ROTATIONS        130
+#define LOG_MESSAGE      "This is a simple message, which fills the log file up to the next rotation."
+
+/// @brief Returns the current wall clock time in seconds.
+static double _now_in_seconds(void) {
+	struct timespec ts;
+	timespec_get(&ts, TIME_UTC);
+	return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+/// @brief Check, if a file exists.
+static bool _file_exists(const char *file_name) {
+	FILE *file = fopen(file_name, "r");
+
+	if (file == NULL) {
+		return false;
+	}
+
+	fclose(file);
+	return true;
+}
+
+/// @brief Remove the log file and every rotated file of both namings.
+static void _remove_log_files(void) {
+	char name[64];
+	remove(LOG_FILE);
+
+	for (int i = 0; i <= 2 * ROTATIONS; i++) {
+		snprintf(name, sizeof(name), "%s.%06d", LOG_FILE, i);
+		remove(name);
+		snprintf(name, sizeof(name), "%s.%d", LOG_FILE, i);
+		remove(name);
+	}
+}
+
+/// @brief Write enough log events for ROTATIONS rotations of 1 MB and print the time.
+static void _run_rotations(Logging *log, const char *description) {
+	init_log(log);
+
+	double start = _now_in_seconds();
+	long long bytes = 0;
+
+	while (bytes < (long long)ROTATIONS * 1024 * 1024) {
+		write_to_log(LOG_INFO, LOG_MESSAGE);
+		bytes += (long long)strlen(LOG_MESSAGE) + 30;
+	}
+
+	dispose();
+	printf("%-22s %d rotations: %8.3f s\n", description, ROTATIONS, _now_in_seconds() - start);
+}
+
+/// @brief Count the rotated files of a naming and return the lowest existing number.
+static int _count_rotated_files(LogRotationNaming naming, int *oldest) {
+	char name[64];
+	int rotated_files = 0;
+	*oldest = -1;
+
+	for (int i = 0; i <= 2 * ROTATIONS; i++) {
+		snprintf(name, sizeof(name), naming == NAMING_SEQUENCE ? "%s.%06d" : "%s.%d", LOG_FILE, i);
+
+		if (_file_exists(name)) {
+			rotated_files++;
+			*oldest = *oldest < 0 ? i : *oldest;
+		}
+	}
+
+	return rotated_files;
+}
+
+int main(void) {
+	// Create a new log construction.
+	// NOTE: With NAMING_SEQUENCE each rotated file gets an increasing number, e.g. "sequence.log.000042".
+	//       A rotation only renames the current log file and removes the oldest rotated file,
+	//       so it doesn't take longer with many keeping files.
+	Logging log = {
+		.on_console_only = false,
+		.init_level = LOG_INFO,
+		.file_name = LOG_FILE,
+		.rotation_setting = SIZE_ROTATION,
+		.nbr_of_keeping_files = KEEPING_FILES,
+		.file_size_in_mb = 1,
+		.keep_file_open = true
+	};
+
+	// the current log file counts as one of the keeping files
+	int oldest;
+	bool valid = true;
+
+	for (int background = 0; background <= 1; background++) {
+		// with background housekeeping a rotation only renames the current log file,
+		// everything else is done by a background thread
+		log.background_housekeeping = background;
+
+		_remove_log_files();
+		log.rotation_naming = NAMING_SHIFT;
+		_run_rotations(&log, background ? "NAMING_SHIFT (bg):" : "NAMING_SHIFT:");
+		valid = _count_rotated_files(NAMING_SHIFT, &oldest) == KEEPING_FILES - 1 && oldest == 1 && valid;
+
+		_remove_log_files();
+		log.rotation_naming = NAMING_SEQUENCE;
+		_run_rotations(&log, background ? "NAMING_SEQUENCE (bg):" : "NAMING_SEQUENCE:");
+
+		// a new log session continues with the next sequence number
+		_run_rotations(&log, background ? "NAMING_SEQUENCE (bg):" : "NAMING_SEQUENCE:");
+		valid = _count_rotated_files(NAMING_SEQUENCE, &oldest) == KEEPING_FILES - 1 && oldest > ROTATIONS && valid;
+	}
+
+	printf("rotated files: %s\n", valid ? "passed" : "FAILED");
+
+	_remove_log_files();
+	return valid ? EXIT_SUCCESS : EXIT_FAILURE;
+}
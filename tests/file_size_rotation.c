@@ -2,10 +2,36 @@
 #include <stdlib.h>
 #include <stdbool.h>
 #include <string.h>
+#include <time.h>
 #include "logging.h"
 
 #define LOG_MESSAGE "This is a simple message."
 
+/// @brief Returns the current wall clock time in seconds.
+static double _now_in_seconds(void) {
+	struct timespec ts;
+	timespec_get(&ts, TIME_UTC);
+	return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+/// @brief Write 3,000,000 log events (of which 2,000,000 are handled) and print the throughput.
+static void _run_size_rotation(Logging *log, const char *description) {
+	init_log(log);
+
+	double start = _now_in_seconds();
+
+	for(int i = 0; i < 500000; i++) {            // repeat 500,000 times
+		for(LogLevel mark = LOG_TRACE; mark <= LOG_FATAL; mark++) {
+			write_to_log(mark, LOG_MESSAGE);
+		}
+	}
+
+	dispose();
+
+	double elapsed = _now_in_seconds() - start;
+	printf("%-28s %8.3f s  (%.0f lines/s)\n", description, elapsed, 2000000.0 / elapsed);
+}
+
 int main(void) {
 	// Create a new log construction.
 	// NOTE: For a rotation, like DAILY_ROTATION or SIZE_ROTATION
@@ -20,15 +46,23 @@ int main(void) {
 		.file_size_in_mb = 10                     // each log file has a maximum size of 10MB
 	};
 
-	init_log(&log);
+	// the log file is opened and closed for each log event
+	_run_size_rotation(&log, "open/close per log event:");
 
-	for(int i = 0; i < 500000; i++) {            // repeat 500,000 times
-		for(LogLevel mark = LOG_TRACE; mark <= LOG_FATAL; mark++) {
-			write_to_log(mark, LOG_MESSAGE);
-		}
-	}
+	// the log file is opened once and stays open until a rotation or dispose()
+	log.keep_file_open = true;
+	_run_size_rotation(&log, "keep file open:");
 
-	dispose();
+	// the log lines are collected in a buffer of 64 KB and written at once
+	// NOTE: LOG_ERROR and LOG_FATAL are written immediately, so in this test a batch
+	//       holds only a few log lines. See: benchmark.c for LOG_INFO only.
+	log.batch_mode = true;
+	log.batch_size_in_kb = 64;
+	_run_size_rotation(&log, "keep file open + batch mode:");
+
+	// even without keep_file_open the log file is opened only once per batch
+	log.keep_file_open = false;
+	_run_size_rotation(&log, "open/close + batch mode:");
 
 	return EXIT_SUCCESS;
-}
\ No newline at end of file
+}
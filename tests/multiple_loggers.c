@@ -0,0 +1,111 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include "logging.h"
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <pthread.h>
+#endif
+
+#define LINES_PER_THREAD  50000
+#define ACCESS_LOG        "access.log"
+#define AUDIT_LOG         "audit.log"
+
+/// @brief Each log session is used by its own thread.
+#ifdef _WIN32
+static DWORD WINAPI _writer(LPVOID argument) {
+#else
+static void *_writer(void *argument) {
+#endif
+	Logger *logger = (Logger *)argument;
+
+	for (int line = 0; line < LINES_PER_THREAD; line++) {
+		// only every second log event is handled by the audit log, since it starts with LOG_WARNING
+		write_to_logger(logger, line % 2 == 0 ? LOG_INFO : LOG_WARNING, "line %06d", line);
+	}
+
+	return 0;
+}
+
+/// @brief Count the lines of a log file.
+static int _count_lines(const char *file_name) {
+	FILE *file = fopen(file_name, "r");
+	char buffer[256];
+	int lines = 0;
+
+	if (file == NULL) {
+		return -1;
+	}
+
+	while (fgets(buffer, sizeof(buffer), file) != NULL) {
+		lines++;
+	}
+
+	fclose(file);
+	return lines;
+}
+
+int main(void) {
+	// Create two independent log sessions.
+	// NOTE: Every log session owns its file, level and rotation state. Two threads are
+	//       able to write into different log sessions without waiting on each other.
+	//       The default log session by init_log() isn't affected at all.
+	Logging access_settings = {
+		.file_name = ACCESS_LOG,
+		.init_level = LOG_INFO,
+		.rotation_setting = NO_ROTATION,
+		.keep_file_open = true
+	};
+
+	Logging audit_settings = {
+		.file_name = AUDIT_LOG,
+		.init_level = LOG_WARNING,
+		.rotation_setting = NO_ROTATION,
+		.keep_file_open = true,
+		.async_mode = true
+	};
+
+	remove(ACCESS_LOG);
+	remove(AUDIT_LOG);
+
+	Logger *access_log = create_logger(&access_settings);
+	Logger *audit_log = create_logger(&audit_settings);
+
+	init_log(NULL);
+	write_to_log(LOG_INFO, "the default log session is still on the console");
+
+	#ifdef _WIN32
+	HANDLE threads[2];
+	threads[0] = CreateThread(NULL, 0, _writer, access_log, 0, NULL);
+	threads[1] = CreateThread(NULL, 0, _writer, audit_log, 0, NULL);
+	WaitForMultipleObjects(2, threads, TRUE, INFINITE);
+	CloseHandle(threads[0]);
+	CloseHandle(threads[1]);
+	#else
+	pthread_t threads[2];
+	pthread_create(&threads[0], NULL, _writer, access_log);
+	pthread_create(&threads[1], NULL, _writer, audit_log);
+	pthread_join(threads[0], NULL);
+	pthread_join(threads[1], NULL);
+	#endif
+
+	destroy_logger(access_log);
+	destroy_logger(audit_log);
+	dispose();
+
+	int access_lines = _count_lines(ACCESS_LOG);
+	int audit_lines = _count_lines(AUDIT_LOG);
+	bool valid = access_lines == LINES_PER_THREAD && audit_lines == LINES_PER_THREAD / 2;
+
+	printf(
+		"%s: %d lines, %s: %d lines: %s\n",
+		ACCESS_LOG, access_lines, AUDIT_LOG, audit_lines, valid ? "passed" : "FAILED"
+	);
+
+	remove(ACCESS_LOG);
+	remove(AUDIT_LOG);
+	return valid ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,164 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include "logging.h"
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <pthread.h>
+#endif
+
+#define NBR_OF_THREADS    16
+#define LINES_PER_THREAD  20000
+#define LOG_FILE          "multithread.log"
+
+/// @brief Every thread writes LINES_PER_THREAD numbered log events.
+#ifdef _WIN32
+static DWORD WINAPI _writer(LPVOID argument) {
+#else
+static void *_writer(void *argument) {
+#endif
+	int thread_id = (int)(size_t)argument;
+
+	for (int line = 0; line < LINES_PER_THREAD; line++) {
+		write_to_log(LOG_INFO, "thread %02d line %06d payload-%s", thread_id, line, "0123456789abcdefghijklmnopqrstuvwxyz");
+	}
+
+	return 0;
+}
+
+/// @brief Start NBR_OF_THREADS threads, which are writing at the same time, and wait for them.
+static void _run_writers(void) {
+	#ifdef _WIN32
+	HANDLE threads[NBR_OF_THREADS];
+
+	for (int i = 0; i < NBR_OF_THREADS; i++) {
+		threads[i] = CreateThread(NULL, 0, _writer, (LPVOID)(size_t)i, 0, NULL);
+	}
+
+	WaitForMultipleObjects(NBR_OF_THREADS, threads, TRUE, INFINITE);
+
+	for (int i = 0; i < NBR_OF_THREADS; i++) {
+		CloseHandle(threads[i]);
+	}
+	#else
+	pthread_t threads[NBR_OF_THREADS];
+
+	for (int i = 0; i < NBR_OF_THREADS; i++) {
+		pthread_create(&threads[i], NULL, _writer, (void *)(size_t)i);
+	}
+
+	for (int i = 0; i < NBR_OF_THREADS; i++) {
+		pthread_join(threads[i], NULL);
+	}
+	#endif
+}
+
+/// @brief Read the log file and check, that every line is complete and no line is lost
+///        or duplicated. The lines of each thread must appear in their original order.
+/// @return true, if the log file is valid, otherwise false
+static bool _verify_log_file(void) {
+	FILE *file = fopen(LOG_FILE, "r");
+
+	if (file == NULL) {
+		fprintf(stderr, "unable to open %s\n", LOG_FILE);
+		return false;
+	}
+
+	int next_line[NBR_OF_THREADS] = {0};
+	char buffer[512];
+	int line_number = 0;
+	bool valid = true;
+
+	while (fgets(buffer, sizeof(buffer), file) != NULL) {
+		line_number++;
+
+		int thread_id = -1;
+		int line = -1;
+		char payload[64] = {0};
+		char end = '\0';
+
+		// "[YYYY-MM-DD HH:MM:SS] [INFO] thread xx line yyyyyy payload-..."
+		int matched = sscanf(buffer, "[%*19c] [INFO] thread %d line %d payload-%63s%c", &thread_id, &line, payload, &end);
+
+		if (
+			matched != 4 || end != '\n' || thread_id < 0 || thread_id >= NBR_OF_THREADS ||
+			strcmp(payload, "0123456789abcdefghijklmnopqrstuvwxyz") != 0
+		) {
+			fprintf(stderr, "torn line %d: %s", line_number, buffer);
+			valid = false;
+			continue;
+		}
+
+		if (line != next_line[thread_id]) {
+			fprintf(stderr, "thread %d: expected line %d, but got %d\n", thread_id, next_line[thread_id], line);
+			valid = false;
+		}
+
+		next_line[thread_id] = line + 1;
+	}
+
+	fclose(file);
+
+	for (int i = 0; i < NBR_OF_THREADS; i++) {
+		if (next_line[i] != LINES_PER_THREAD) {
+			fprintf(stderr, "thread %d: %d of %d lines found\n", i, next_line[i], LINES_PER_THREAD);
+			valid = false;
+		}
+	}
+
+	return valid;
+}
+
+/// @brief Let all threads write into a fresh log file and verify the result.
+static bool _run_stress_test(Logging *log, const char *description) {
+	remove(LOG_FILE);
+	init_log(log);
+	_run_writers();
+	dispose();
+
+	bool valid = _verify_log_file();
+	printf("%-20s %d threads x %d lines: %s\n", description, NBR_OF_THREADS, LINES_PER_THREAD, valid ? "passed" : "FAILED");
+	return valid;
+}
+
+int main(void) {
+	// Create a new log construction.
+	// NOTE: Many threads are writing into the same log file at the same time.
+	//       Every log event must appear as a complete line and no log event
+	//       may be lost.
+	Logging log = {
+		.on_console_only = false,
+		.init_level = LOG_INFO,
+		.file_name = LOG_FILE,
+		.rotation_setting = NO_ROTATION,
+
+		// are going to ignore
+		.file_size_in_mb = 0,
+		.nbr_of_keeping_files = 0
+	};
+
+	bool valid = _run_stress_test(&log, "open/close:");
+
+	log.keep_file_open = true;
+	valid = _run_stress_test(&log, "keep file open:") && valid;
+
+	// the caller must wait on a full queue, otherwise log events might be dropped
+	log.async_mode = true;
+	log.async_queue_size = 256;
+	log.overflow_policy = OVERFLOW_BLOCK;
+	valid = _run_stress_test(&log, "async mode:") && valid;
+
+	// the log lines are collected and written by a few large writes
+	log.async_mode = false;
+	log.batch_mode = true;
+	valid = _run_stress_test(&log, "batch mode:") && valid;
+
+	log.async_mode = true;
+	valid = _run_stress_test(&log, "async batch mode:") && valid;
+
+	remove(LOG_FILE);
+	return valid ? EXIT_SUCCESS : EXIT_FAILURE;
+}